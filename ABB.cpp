@@ -1,7 +1,12 @@
 #include <iostream>
-#include <queue>
 #include <string>
 #include <fstream>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "graphviz.h"
+#include "traversal.h"
 using namespace std;
 
 // Estrutura de nó para a árvore binária
@@ -40,53 +45,71 @@ bool search(Node* node, int value) {
     return search(node->left, value) || search(node->right, value);
 }
 
+// Iteradores sobre as chaves em ordem a partir de uma posição qualquer
+// (ver PathIterator em traversal.h)
+using AbbIterator = PathIterator<Node*, LeftChild<Node>, RightChild<Node>>;
+using AbbReverseIterator = PathIterator<Node*, LeftChild<Node>, RightChild<Node>, false>;
+
+AbbIterator abbEnd(Node* root) {
+    return AbbIterator(root, LeftChild<Node>(), RightChild<Node>());
+}
+
+// Primeiro nó com chave >= value, ou o fim. A descida é iterativa, O(altura)
+AbbIterator lowerBound(Node* root, int value) {
+    auto before = [value](Node* node) { return node->value < value; };
+    return AbbIterator(root, seekFirst(root, LeftChild<Node>(), RightChild<Node>(), before), LeftChild<Node>(),
+                       RightChild<Node>());
+}
+
+// Primeiro nó com chave > value, ou o fim
+AbbIterator upperBound(Node* root, int value) {
+    auto before = [value](Node* node) { return node->value <= value; };
+    return AbbIterator(root, seekFirst(root, LeftChild<Node>(), RightChild<Node>(), before), LeftChild<Node>(),
+                       RightChild<Node>());
+}
+
+// Chaves de [low, high] em ordem crescente, O(altura + k) para k chaves
+IteratorRange<AbbIterator> rangeScan(Node* root, int low, int high) {
+    if (low > high) return IteratorRange<AbbIterator>{abbEnd(root), abbEnd(root)};
+    return IteratorRange<AbbIterator>{lowerBound(root, low), upperBound(root, high)};
+}
+
+// As mesmas chaves em ordem decrescente
+IteratorRange<AbbReverseIterator> rangeScanReverse(Node* root, int low, int high) {
+    LeftChild<Node> left;
+    RightChild<Node> right;
+    AbbReverseIterator end(root, left, right);
+    if (low > high) return IteratorRange<AbbReverseIterator>{end, end};
+    auto notAboveHigh = [high](Node* node) { return node->value <= high; };
+    auto belowLow = [low](Node* node) { return node->value < low; };
+    return IteratorRange<AbbReverseIterator>{
+        AbbReverseIterator(root, seekLast(root, left, right, notAboveHigh), left, right),
+        AbbReverseIterator(root, seekLast(root, left, right, belowLow), left, right)};
+}
+
 // Função para percorrer a árvore em pré-ordem
 void preorder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    cout << node->value << " ";
-    preorder(node->left);
-    preorder(node->right);
+    preorderVisit(node, [](Node* n) { cout << n->value << " "; });
 }
 
 // Função para percorrer a árvore em ordem
 void inorder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    inorder(node->left);
-    cout << node->value << " ";
-    inorder(node->right);
+    inorderVisit(node, [](Node* n) { cout << n->value << " "; });
 }
 
 // Função para percorrer a árvore em pós-ordem
 void postorder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    postorder(node->left);
-    postorder(node->right);
-    cout << node->value << " ";
+    postorderVisit(node, [](Node* n) { cout << n->value << " "; });
 }
 
 // Função para imprimir a árvore no nível
 void levelOrder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    queue<Node*> q;
-    q.push(node);
-
-    while (!q.empty()) {
-        Node* current = q.front();
-        q.pop();
-
-        cout << current->value << " ";
+    levelOrderVisit(node, [](Node* n) { cout << n->value << " "; });
+}
 
-        if (current->left) q.push(current->left);
-        if (current->right) q.push(current->right);
-    }
+// Libera todos os nós da árvore
+void destroyTree(Node* root) {
+    postorderVisit(root, [](Node* n) { delete n; });
 }
 
 // Função auxiliar para remover o menor valor de uma subárvore
@@ -138,53 +161,115 @@ void printTree(Node* node, int depth = 0) {
     printTree(node->left, depth + 1);
 }
 
-void generateGraphviz(Node* node, ofstream& file, int& nodeId) {
-    if (node == nullptr) {
+// Função para gerar o arquivo DOT e salvar o gráfico (percurso iterativo,
+// sem risco de estourar a pilha em árvores degeneradas)
+void saveGraphToFile(Node* root, const string& filename) {
+    bool saved;
+    if (root) {
+        auto children = [](Node* node, auto visit) {
+            if (node->left) visit(node->left);
+            if (node->right) visit(node->right);
+        };
+        auto label = [](Node* node, DotWriter& out) { out << node->value; };
+        saved = saveGraphviz(filename, root, children, label).written;
+    } else {
+        saved = saveEmptyGraphviz(filename);
+    }
+
+    if (!saved) {
+        cerr << "Erro ao abrir o arquivo!" << endl;
         return;
     }
+    cout << "Árvore gerada no formato Graphviz em " << filename << endl;
+}
 
-    // Cria um nó no formato DOT
-    file << "  node" << nodeId << " [label=\"" << node->value << "\"];\n";
+// Árvore degenerada com 0..n-1, a mesma que inserções em ordem crescente
+// produziriam, montada diretamente (insert recursivo seria O(n^2))
+Node* buildDegenerate(int n) {
+    Node* root = nullptr;
+    for (int value = n - 1; value >= 0; value--) {
+        root = new Node{value, nullptr, root};
+    }
+    return root;
+}
 
-    // Cria uma variável para o próximo nodeId
-    int nextNodeId = nodeId + 1;
+// Percursos iterativos x recursivos em ABBs aleatórias e degeneradas
+void benchmarkTraversal() {
+    const int sizes[] = {1000, 100000, 1000000};
+    mt19937 rng(42);
 
-    // Se houver filho à esquerda, cria a aresta e chama recursivamente
-    if (node->left != nullptr) {
-        file << "  node" << nodeId << " -> node" << nextNodeId << ";\n";
-        generateGraphviz(node->left, file, nextNodeId);
+    for (int n : sizes) {
+        Node* root = nullptr;
+        for (int i = 0; i < n; i++) {
+            root = insert(root, rng());
+        }
+        long nodes = 0;
+        inorderVisit(root, [&nodes](Node*) { nodes++; });
+        reportTraversalTimes("ABB aleatória", root, nodes, true);
+        destroyTree(root);
     }
 
-    // Se houver filho à direita, cria a aresta e chama recursivamente
-    if (node->right != nullptr) {
-        file << "  node" << nodeId << " -> node" << nextNodeId << ";\n";
-        generateGraphviz(node->right, file, nextNodeId);
+    // Com 10^6 nós em linha a recursão estouraria a pilha de chamadas
+    const int degenerateSizes[] = {10000, 1000000};
+    for (int n : degenerateSizes) {
+        Node* root = buildDegenerate(n);
+        reportTraversalTimes("ABB degenerada", root, n, n <= 10000);
+        destroyTree(root);
     }
-
-    // Incrementa o nodeId após processar os filhos
-    nodeId = nextNodeId;
 }
 
-// Função para gerar o arquivo DOT e salvar o gráfico
-void saveGraphToFile(Node* root, const string& filename) {
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo!" << endl;
-        return;
+// Latência de consultas de intervalo numa ABB aleatória com 10^7 chaves,
+// com k de 1 a 10^6 resultados, nos dois sentidos
+void benchmarkRangeScan() {
+    const int n = 10000000;
+    mt19937 rng(42);
+    vector<int> keys;
+    keys.reserve(n);
+    Node* root = nullptr;
+    while ((int)keys.size() < n) {
+        int value = rng();
+        keys.push_back(value);
+        root = insert(root, value);
     }
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    int distinct = keys.size();
 
-    // Começo do gráfico no formato DOT
-    file << "digraph G {\n";
-    file << "node [shape=circle];\n";  // Definindo o estilo do nó como "circle"
-
-    int nodeId = 0;  // Inicializa o nodeId
-    generateGraphviz(root, file, nodeId);  // Chama a função para gerar os nós e as arestas
-
-    // Fim do gráfico
-    file << "}\n";
-    file.close();
+    const int counts[] = {1, 10, 100, 10000, 1000000};
+    for (int k : counts) {
+        // Intervalos [keys[i], keys[i + k - 1]], com exatamente k chaves
+        int queries = max(20, min(200000, 20000000 / k));
+        vector<int> starts(queries);
+        for (int& i : starts) i = rng() % (distinct - k + 1);
 
-    cout << "Árvore gerada no formato Graphviz em " << filename << endl;
+        double times[2];
+        long long sums[2] = {0, 0};
+        bool correct = true;
+        for (int direction = 0; direction < 2; direction++) {
+            long long& sum = sums[direction];
+            auto start = chrono::steady_clock::now();
+            for (int i : starts) {
+                long found = 0;
+                if (direction == 0) {
+                    for (Node* node : rangeScan(root, keys[i], keys[i + k - 1])) {
+                        sum += node->value;
+                        found++;
+                    }
+                } else {
+                    for (Node* node : rangeScanReverse(root, keys[i], keys[i + k - 1])) {
+                        sum += node->value;
+                        found++;
+                    }
+                }
+                correct = correct && found == k;
+            }
+            times[direction] = chrono::duration<double>(chrono::steady_clock::now() - start).count() / queries * 1e6;
+        }
+        correct = correct && sums[0] == sums[1];
+        cout << "k = " << k << " | crescente: " << times[0] << " us (" << times[0] * 1e3 / k << " ns/chave)"
+             << " | decrescente: " << times[1] << " us" << (correct ? "" : " | ERRO: quantidade errada") << endl;
+    }
+    destroyTree(root);
 }
 
 int main() {
@@ -192,7 +277,7 @@ int main() {
     int choice, key;
 
     while (true) {
-        cout << "\n1. Inserir\n2. Remover\n3. Buscar\n4. Percurso Pré-Ordem\n5. Percurso Em Ordem\n6. Percurso Pós-Ordem\n7. Percurso Nível\n8. Imprimir Árvore\n9. Gerar Grafo\n10. Sair\nEscolha uma opção: ";
+        cout << "\n1. Inserir\n2. Remover\n3. Buscar\n4. Percurso Pré-Ordem\n5. Percurso Em Ordem\n6. Percurso Pós-Ordem\n7. Percurso Nível\n8. Imprimir Árvore\n9. Gerar Grafo\n10. Benchmark de Percursos\n11. Listar Intervalo\n12. Benchmark de Intervalos\n13. Sair\nEscolha uma opção: ";
         cin >> choice;
 
         switch (choice) {
@@ -250,6 +335,21 @@ int main() {
                 saveGraphToFile(root, "tree.dot");
                 break;
             case 10:
+                benchmarkTraversal();
+                break;
+            case 11: {
+                int low, high;
+                cout << "Digite o início e o fim do intervalo: ";
+                cin >> low >> high;
+                cout << "Valores em [" << low << ", " << high << "]: ";
+                for (Node* node : rangeScan(root, low, high)) cout << node->value << " ";
+                cout << endl;
+                break;
+            }
+            case 12:
+                benchmarkRangeScan();
+                break;
+            case 13:
                 cout << "Saindo...\n";
                 return 0;
             default:
@@ -1,238 +1,1637 @@
 #include <iostream>
 #include <algorithm>
 #include <fstream>
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include "graphviz.h"
+#include "traversal.h"
 using namespace std;
 
+// Os nós ficam num pool contíguo (um vetor) e se referem uns aos outros por
+// índices de 31 bits; o índice 0 é o nó nulo. Em vez da altura, cada nó
+// guarda só o fator de balanceamento, no bit que sobra em cada ligação: o
+// bit alto de left marca a esquerda mais alta e o de right marca a direita
+// mais alta. Cada nó guarda ainda o tamanho da própria subárvore, usado
+// pelas consultas de ordem (rankOf, select, countRange). São 16 bytes por
+// nó contra 32 da versão com ponteiros e altura. Nós removidos vão para
+// uma lista livre (encadeada pelo campo value) e são reaproveitados pelas
+// próximas inserções. Cada entrada da lista é a raiz de uma subárvore
+// inteira a liberar: as operações de conjuntos descartam subárvores em
+// O(1), e os filhos só entram na lista quando o nó é reaproveitado.
+const uint32_t INDEX_MASK = 0x7fffffff;
+const uint32_t HEAVY_BIT = 0x80000000;
+
 struct Node {
     int value;
-    Node* left;
-    Node* right;
-    int height;
+    uint32_t left;   // índice | HEAVY_BIT se altura(esquerda) = altura(direita) + 1
+    uint32_t right;  // índice | HEAVY_BIT se altura(direita) = altura(esquerda) + 1
+    uint32_t size;   // nós na subárvore, contando o próprio
+};
+
+struct AvlTree {
+    vector<Node> nodes;  // nodes[0] é o nó nulo
+    uint32_t root;
+    uint32_t freeList;
+    size_t size;
+
+    AvlTree() : nodes(1, Node{0, 0, 0, 0}), root(0), freeList(0), size(0) {}
+};
+
+inline uint32_t leftOf(const AvlTree& tree, uint32_t node) {
+    return tree.nodes[node].left & INDEX_MASK;
+}
+
+inline uint32_t rightOf(const AvlTree& tree, uint32_t node) {
+    return tree.nodes[node].right & INDEX_MASK;
+}
+
+// Tamanho da subárvore; o nó nulo tem tamanho 0
+inline uint32_t sizeOf(const AvlTree& tree, uint32_t node) {
+    return tree.nodes[node].size;
+}
+
+// Trocam o filho sem mexer no bit de balanceamento
+inline void setLeft(AvlTree& tree, uint32_t node, uint32_t child) {
+    tree.nodes[node].left = (tree.nodes[node].left & HEAVY_BIT) | child;
+}
 
-    Node(int val) : value(val), left(nullptr), right(nullptr), height(1) {}
+inline void setRight(AvlTree& tree, uint32_t node, uint32_t child) {
+    tree.nodes[node].right = (tree.nodes[node].right & HEAVY_BIT) | child;
+}
+
+// Recalcula o tamanho a partir dos filhos
+inline void updateSize(AvlTree& tree, uint32_t node) {
+    tree.nodes[node].size = sizeOf(tree, leftOf(tree, node)) + sizeOf(tree, rightOf(tree, node)) + 1;
+}
+
+// Acessores dos filhos, para os percursos de traversal.h
+struct AvlLeft {
+    const AvlTree* tree;
+    uint32_t operator()(uint32_t node) const { return leftOf(*tree, node); }
+};
+
+struct AvlRight {
+    const AvlTree* tree;
+    uint32_t operator()(uint32_t node) const { return rightOf(*tree, node); }
 };
 
-// Função para obter a altura do nó
-int getHeight(Node* node) {
-    return node ? node->height : 0;
+// Põe a subárvore node na lista livre, sem percorrê-la
+inline void pushFree(AvlTree& tree, uint32_t node) {
+    tree.nodes[node].value = (int)tree.freeList;
+    tree.freeList = node;
 }
 
-// Função para calcular o fator de balanceamento
-int getBalanceFactor(Node* node) {
-    return node ? getHeight(node->left) - getHeight(node->right) : 0;
+// Reserva um nó, da lista livre ou do fim do pool
+uint32_t newNode(AvlTree& tree, int value) {
+    uint32_t index;
+    if (tree.freeList) {
+        index = tree.freeList;
+        Node& node = tree.nodes[index];
+        tree.freeList = (uint32_t)node.value;
+        if (node.left & INDEX_MASK) pushFree(tree, node.left & INDEX_MASK);
+        if (node.right & INDEX_MASK) pushFree(tree, node.right & INDEX_MASK);
+        node = Node{value, 0, 0, 1};
+    } else {
+        index = tree.nodes.size();
+        tree.nodes.push_back(Node{value, 0, 0, 1});
+    }
+    tree.size++;
+    return index;
 }
 
-// Rotação à direita
-Node* rotateRight(Node* y) {
-    Node* x = y->left;
-    Node* T = x->right;
+void freeNode(AvlTree& tree, uint32_t index) {
+    tree.nodes[index].left = tree.nodes[index].right = 0;
+    pushFree(tree, index);
+    tree.size--;
+}
 
-    // Realiza a rotação
-    x->right = y;
-    y->left = T;
+// Função para obter o fator de balanceamento: altura(esquerda) - altura(direita)
+int getBalanceFactor(const AvlTree& tree, uint32_t node) {
+    return (int)(tree.nodes[node].left >> 31) - (int)(tree.nodes[node].right >> 31);
+}
 
-    // Atualiza as alturas
-    y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
-    x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
+void setBalanceFactor(AvlTree& tree, uint32_t node, int balance) {
+    Node& n = tree.nodes[node];
+    n.left = (n.left & INDEX_MASK) | (balance > 0 ? HEAVY_BIT : 0);
+    n.right = (n.right & INDEX_MASK) | (balance < 0 ? HEAVY_BIT : 0);
+}
 
+// Rotação à direita (ligações e tamanhos; os fatores são ajustados por
+// quem chama)
+uint32_t rotateRight(AvlTree& tree, uint32_t y) {
+    uint32_t x = leftOf(tree, y);
+    setLeft(tree, y, rightOf(tree, x));
+    setRight(tree, x, y);
+    updateSize(tree, y);
+    updateSize(tree, x);
     return x;
 }
 
 // Rotação à esquerda
-Node* rotateLeft(Node* x) {
-    Node* y = x->right;
-    Node* T = y->left;
+uint32_t rotateLeft(AvlTree& tree, uint32_t x) {
+    uint32_t y = rightOf(tree, x);
+    setRight(tree, x, leftOf(tree, y));
+    setLeft(tree, y, x);
+    updateSize(tree, x);
+    updateSize(tree, y);
+    return y;
+}
 
-    // Realiza a rotação
-    y->left = x;
-    x->right = T;
+// Rebalanceia um nó cuja esquerda ficou dois níveis mais alta que a
+// direita. shrank indica se a subárvore ficou um nível mais baixa do que
+// estava com o desequilíbrio
+uint32_t rebalanceLeft(AvlTree& tree, uint32_t node, bool& shrank) {
+    uint32_t child = leftOf(tree, node);
+    int childBalance = getBalanceFactor(tree, child);
 
-    // Atualiza as alturas
-    x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
-    y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
+    if (childBalance >= 0) {
+        // Rotação simples à direita
+        uint32_t root = rotateRight(tree, node);
+        setBalanceFactor(tree, node, childBalance == 0 ? 1 : 0);
+        setBalanceFactor(tree, root, childBalance == 0 ? -1 : 0);
+        shrank = childBalance != 0;
+        return root;
+    }
 
-    return y;
+    // Rotação dupla: esquerda-direita
+    uint32_t grandchild = rightOf(tree, child);
+    int grandchildBalance = getBalanceFactor(tree, grandchild);
+    setLeft(tree, node, rotateLeft(tree, child));
+    uint32_t root = rotateRight(tree, node);
+    setBalanceFactor(tree, child, grandchildBalance < 0 ? 1 : 0);
+    setBalanceFactor(tree, node, grandchildBalance > 0 ? -1 : 0);
+    setBalanceFactor(tree, root, 0);
+    shrank = true;
+    return root;
 }
 
-// Função auxiliar para inserção
-Node* insertRec(Node* node, int value) {
-    if (!node) return new Node(value);
+// Simétrica: a direita ficou dois níveis mais alta
+uint32_t rebalanceRight(AvlTree& tree, uint32_t node, bool& shrank) {
+    uint32_t child = rightOf(tree, node);
+    int childBalance = getBalanceFactor(tree, child);
 
-    if (value < node->value) {
-        node->left = insertRec(node->left, value);
-    } else if (value > node->value) {
-        node->right = insertRec(node->right, value);
-    } else {
-        // Duplicados não são permitidos
-        return node;
+    if (childBalance <= 0) {
+        // Rotação simples à esquerda
+        uint32_t root = rotateLeft(tree, node);
+        setBalanceFactor(tree, node, childBalance == 0 ? -1 : 0);
+        setBalanceFactor(tree, root, childBalance == 0 ? 1 : 0);
+        shrank = childBalance != 0;
+        return root;
     }
 
-    // Atualiza a altura do nó
-    node->height = max(getHeight(node->left), getHeight(node->right)) + 1;
+    // Rotação dupla: direita-esquerda
+    uint32_t grandchild = leftOf(tree, child);
+    int grandchildBalance = getBalanceFactor(tree, grandchild);
+    setRight(tree, node, rotateRight(tree, child));
+    uint32_t root = rotateLeft(tree, node);
+    setBalanceFactor(tree, child, grandchildBalance > 0 ? -1 : 0);
+    setBalanceFactor(tree, node, grandchildBalance < 0 ? 1 : 0);
+    setBalanceFactor(tree, root, 0);
+    shrank = true;
+    return root;
+}
 
-    // Calcula o fator de balanceamento
-    int balance = getBalanceFactor(node);
+// Função para buscar um valor na árvore; devolve 0 se não encontrar. A
+// ligação escolhida é lida inteira (com o bit de balanceamento) e só
+// mascarada ao virar índice, o que deixa o compilador usar cmov em vez de
+// um desvio imprevisível a cada nível
+uint32_t search(const AvlTree& tree, int value) {
+    const Node* nodes = tree.nodes.data();
+    uint32_t link = tree.root;
+    while (link & INDEX_MASK) {
+        const Node& node = nodes[link & INDEX_MASK];
+        if (node.value == value) break;
+        link = value < node.value ? node.left : node.right;
+    }
+    return link & INDEX_MASK;
+}
 
-    // Verifica os casos de desbalanceamento
-    if (balance > 1 && value < node->left->value) {
-        return rotateRight(node); // Rotação simples à direita
+// Função auxiliar para encontrar o nó com o valor mínimo
+uint32_t getMinNode(const AvlTree& tree, uint32_t node) {
+    while (node && leftOf(tree, node)) {
+        node = leftOf(tree, node);
     }
-    if (balance < -1 && value > node->right->value) {
-        return rotateLeft(node); // Rotação simples à esquerda
+    return node;
+}
+
+// Consultas de ordem: descem uma vez da raiz somando os tamanhos das
+// subárvores deixadas à esquerda, O(log n)
+
+// Quantidade de chaves menores que value, ou seja, a posição (a partir de
+// 0) que value ocupa ou ocuparia em ordem
+size_t rankOf(const AvlTree& tree, int value) {
+    size_t count = 0;
+    uint32_t node = tree.root;
+    while (node) {
+        if (value <= tree.nodes[node].value) {
+            node = leftOf(tree, node);
+        } else {
+            count += sizeOf(tree, leftOf(tree, node)) + 1;
+            node = rightOf(tree, node);
+        }
     }
-    if (balance > 1 && value > node->left->value) {
-        node->left = rotateLeft(node->left);
-        return rotateRight(node); // Rotação dupla: esquerda-direita
+    return count;
+}
+
+// Quantidade de chaves menores ou iguais a value
+size_t rankUpperOf(const AvlTree& tree, int value) {
+    size_t count = 0;
+    uint32_t node = tree.root;
+    while (node) {
+        if (value < tree.nodes[node].value) {
+            node = leftOf(tree, node);
+        } else {
+            count += sizeOf(tree, leftOf(tree, node)) + 1;
+            node = rightOf(tree, node);
+        }
     }
-    if (balance < -1 && value < node->right->value) {
-        node->right = rotateRight(node->right);
-        return rotateLeft(node); // Rotação dupla: direita-esquerda
+    return count;
+}
+
+// Nó com a k-ésima menor chave (k a partir de 0); 0 se k >= tamanho
+uint32_t select(const AvlTree& tree, size_t k) {
+    uint32_t node = tree.root;
+    while (node) {
+        size_t leftSize = sizeOf(tree, leftOf(tree, node));
+        if (k == leftSize) return node;
+        if (k < leftSize) {
+            node = leftOf(tree, node);
+        } else {
+            k -= leftSize + 1;
+            node = rightOf(tree, node);
+        }
     }
+    return 0;
+}
+
+// Quantidade de chaves no intervalo fechado [low, high]
+size_t countRange(const AvlTree& tree, int low, int high) {
+    if (low > high) return 0;
+    return rankUpperOf(tree, high) - rankOf(tree, low);
+}
+
+// Iteradores sobre as chaves em ordem a partir de uma posição qualquer
+// (ver PathIterator em traversal.h); o valor do iterador é o índice do nó
+using AvlIterator = PathIterator<uint32_t, AvlLeft, AvlRight>;
+using AvlReverseIterator = PathIterator<uint32_t, AvlLeft, AvlRight, false>;
+
+AvlIterator avlEnd(const AvlTree& tree) {
+    return AvlIterator(tree.root, AvlLeft{&tree}, AvlRight{&tree});
+}
 
+// Primeiro nó com chave >= value, ou o fim
+AvlIterator lowerBound(const AvlTree& tree, int value) {
+    auto before = [&tree, value](uint32_t node) { return tree.nodes[node].value < value; };
+    return AvlIterator(tree.root, seekFirst(tree.root, AvlLeft{&tree}, AvlRight{&tree}, before), AvlLeft{&tree},
+                       AvlRight{&tree});
+}
+
+// Primeiro nó com chave > value, ou o fim
+AvlIterator upperBound(const AvlTree& tree, int value) {
+    auto before = [&tree, value](uint32_t node) { return tree.nodes[node].value <= value; };
+    return AvlIterator(tree.root, seekFirst(tree.root, AvlLeft{&tree}, AvlRight{&tree}, before), AvlLeft{&tree},
+                       AvlRight{&tree});
+}
+
+// Chaves de [low, high] em ordem crescente, O(log n + k) para k chaves:
+// for (uint32_t node : rangeScan(tree, a, b)) ...
+IteratorRange<AvlIterator> rangeScan(const AvlTree& tree, int low, int high) {
+    if (low > high) return IteratorRange<AvlIterator>{avlEnd(tree), avlEnd(tree)};
+    return IteratorRange<AvlIterator>{lowerBound(tree, low), upperBound(tree, high)};
+}
+
+// As mesmas chaves em ordem decrescente: do último nó <= high até antes do
+// último nó < low
+IteratorRange<AvlReverseIterator> rangeScanReverse(const AvlTree& tree, int low, int high) {
+    AvlLeft left{&tree};
+    AvlRight right{&tree};
+    AvlReverseIterator end(tree.root, left, right);
+    if (low > high) return IteratorRange<AvlReverseIterator>{end, end};
+    auto notAboveHigh = [&tree, high](uint32_t node) { return tree.nodes[node].value <= high; };
+    auto belowLow = [&tree, low](uint32_t node) { return tree.nodes[node].value < low; };
+    return IteratorRange<AvlReverseIterator>{
+        AvlReverseIterator(tree.root, seekLast(tree.root, left, right, notAboveHigh), left, right),
+        AvlReverseIterator(tree.root, seekLast(tree.root, left, right, belowLow), left, right)};
+}
+
+// Ajusta o nó depois que a subárvore da esquerda (ou da direita) ficou
+// um nível mais alta; grew passa a indicar se o próprio nó cresceu
+uint32_t leftGrew(AvlTree& tree, uint32_t node, bool& grew) {
+    int balance = getBalanceFactor(tree, node);
+    if (balance == 0) {
+        setBalanceFactor(tree, node, 1);
+        return node;
+    }
+    grew = false;
+    if (balance < 0) {
+        setBalanceFactor(tree, node, 0);
+        return node;
+    }
+    // Na inserção a rotação sempre devolve a altura de antes; numa junção
+    // (join) o filho pode estar balanceado e a subárvore continua mais alta
+    bool shrank;
+    node = rebalanceLeft(tree, node, shrank);
+    grew = !shrank;
     return node;
 }
 
-// Função para buscar um valor na árvore
-Node* search(Node* root, int value) {
-    if (!root || root->value == value) return root;
-    if (value < root->value) return search(root->left, value);
-    return search(root->right, value);
+uint32_t rightGrew(AvlTree& tree, uint32_t node, bool& grew) {
+    int balance = getBalanceFactor(tree, node);
+    if (balance == 0) {
+        setBalanceFactor(tree, node, -1);
+        return node;
+    }
+    grew = false;
+    if (balance > 0) {
+        setBalanceFactor(tree, node, 0);
+        return node;
+    }
+    // Na inserção a rotação sempre devolve a altura de antes; numa junção
+    // (join) o filho pode estar balanceado e a subárvore continua mais alta
+    bool shrank;
+    node = rebalanceRight(tree, node, shrank);
+    grew = !shrank;
+    return node;
 }
 
-// Função auxiliar para encontrar o nó com o valor mínimo
-Node* getMinNode(Node* node) {
-    Node* current = node;
-    while (current && current->left) {
-        current = current->left;
+// Ajusta o nó depois que a subárvore da esquerda (ou da direita) ficou
+// um nível mais baixa; shrank passa a indicar se o próprio nó encolheu
+uint32_t leftShrank(AvlTree& tree, uint32_t node, bool& shrank) {
+    int balance = getBalanceFactor(tree, node);
+    if (balance > 0) {
+        setBalanceFactor(tree, node, 0);
+        return node;
+    }
+    if (balance == 0) {
+        setBalanceFactor(tree, node, -1);
+        shrank = false;
+        return node;
+    }
+    return rebalanceRight(tree, node, shrank);
+}
+
+uint32_t rightShrank(AvlTree& tree, uint32_t node, bool& shrank) {
+    int balance = getBalanceFactor(tree, node);
+    if (balance < 0) {
+        setBalanceFactor(tree, node, 0);
+        return node;
+    }
+    if (balance == 0) {
+        setBalanceFactor(tree, node, 1);
+        shrank = false;
+        return node;
+    }
+    return rebalanceLeft(tree, node, shrank);
+}
+
+// Altura máxima de uma AVL com até 2^31 nós (1.44 log2 n) com folga
+const int AVL_MAX_HEIGHT = 64;
+
+// Caminho da raiz até um nó: os nós e o lado tomado em cada um
+struct AvlPath {
+    uint32_t nodes[AVL_MAX_HEIGHT];
+    bool wentLeft[AVL_MAX_HEIGHT];
+    int depth;
+};
+
+// Liga a subárvore que ficou no lugar de path.nodes[level] ao pai dela;
+// root é a raiz da árvore a que o caminho pertence
+void replaceOnPath(AvlTree& tree, const AvlPath& path, int level, uint32_t subtree, uint32_t& root) {
+    if (level == 0) {
+        root = subtree;
+    } else if (path.wentLeft[level - 1]) {
+        setLeft(tree, path.nodes[level - 1], subtree);
+    } else {
+        setRight(tree, path.nodes[level - 1], subtree);
+    }
+}
+
+// Inserção iterativa: desce guardando o caminho e depois sobe ajustando
+// os fatores só até a primeira subárvore cuja altura não mudou
+void insert(AvlTree& tree, int value) {
+    AvlPath path;
+    path.depth = 0;
+    uint32_t node = tree.root;
+    while (node) {
+        int current = tree.nodes[node].value;
+        if (value == current) return;  // Duplicados não são permitidos
+        path.nodes[path.depth] = node;
+        path.wentLeft[path.depth] = value < current;
+        path.depth++;
+        node = value < current ? leftOf(tree, node) : rightOf(tree, node);
+    }
+
+    replaceOnPath(tree, path, path.depth, newNode(tree, value), tree.root);
+    // Os tamanhos mudam no caminho inteiro, mesmo onde a altura não muda
+    for (int level = 0; level < path.depth; level++) tree.nodes[path.nodes[level]].size++;
+
+    bool grew = true;
+    for (int level = path.depth - 1; level >= 0 && grew; level--) {
+        node = path.nodes[level];
+        uint32_t subtree = path.wentLeft[level] ? leftGrew(tree, node, grew) : rightGrew(tree, node, grew);
+        if (subtree != node) replaceOnPath(tree, path, level, subtree, tree.root);
+    }
+}
+
+// Remoção iterativa: o caminho vai até o nó que sai de fato (o próprio nó,
+// ou o sucessor quando há dois filhos), e a subida para assim que uma
+// subárvore mantém a altura
+void remove(AvlTree& tree, int value) {
+    AvlPath path;
+    path.depth = 0;
+    uint32_t node = tree.root;
+    while (node && tree.nodes[node].value != value) {
+        path.nodes[path.depth] = node;
+        path.wentLeft[path.depth] = value < tree.nodes[node].value;
+        node = path.wentLeft[path.depth] ? leftOf(tree, node) : rightOf(tree, node);
+        path.depth++;
+    }
+    if (!node) return;
+
+    // Nó com dois filhos: copia o sucessor e remove o nó dele
+    if (leftOf(tree, node) && rightOf(tree, node)) {
+        uint32_t target = node;
+        path.nodes[path.depth] = node;
+        path.wentLeft[path.depth] = false;
+        path.depth++;
+        node = rightOf(tree, node);
+        while (leftOf(tree, node)) {
+            path.nodes[path.depth] = node;
+            path.wentLeft[path.depth] = true;
+            path.depth++;
+            node = leftOf(tree, node);
+        }
+        tree.nodes[target].value = tree.nodes[node].value;
+    }
+
+    uint32_t child = leftOf(tree, node) ? leftOf(tree, node) : rightOf(tree, node);
+    replaceOnPath(tree, path, path.depth, child, tree.root);
+    freeNode(tree, node);
+    for (int level = 0; level < path.depth; level++) tree.nodes[path.nodes[level]].size--;
+
+    bool shrank = true;
+    for (int level = path.depth - 1; level >= 0 && shrank; level--) {
+        node = path.nodes[level];
+        uint32_t subtree = path.wentLeft[level] ? leftShrank(tree, node, shrank) : rightShrank(tree, node, shrank);
+        if (subtree != node) replaceOnPath(tree, path, level, subtree, tree.root);
+    }
+}
+
+// Versões recursivas, mantidas como referência para o benchmark. grew e
+// shrank indicam se a altura da subárvore mudou
+uint32_t insertRec(AvlTree& tree, uint32_t node, int value, bool& grew) {
+    if (!node) {
+        grew = true;
+        return newNode(tree, value);
+    }
+
+    if (value < tree.nodes[node].value) {
+        uint32_t child = insertRec(tree, leftOf(tree, node), value, grew);
+        setLeft(tree, node, child);
+        updateSize(tree, node);
+        if (grew) node = leftGrew(tree, node, grew);
+    } else if (value > tree.nodes[node].value) {
+        uint32_t child = insertRec(tree, rightOf(tree, node), value, grew);
+        setRight(tree, node, child);
+        updateSize(tree, node);
+        if (grew) node = rightGrew(tree, node, grew);
+    } else {
+        grew = false;
     }
-    return current;
+
+    return node;
 }
 
-// Função auxiliar para remoção de um nó
-Node* deleteRec(Node* root, int value) {
-    if (!root) return root;
+uint32_t deleteRec(AvlTree& tree, uint32_t node, int value, bool& shrank) {
+    if (!node) {
+        shrank = false;
+        return node;
+    }
 
-    // Realiza a busca do nó a ser removido
-    if (value < root->value) {
-        root->left = deleteRec(root->left, value);
-    } else if (value > root->value) {
-        root->right = deleteRec(root->right, value);
+    if (value < tree.nodes[node].value) {
+        uint32_t child = deleteRec(tree, leftOf(tree, node), value, shrank);
+        setLeft(tree, node, child);
+        updateSize(tree, node);
+        if (shrank) node = leftShrank(tree, node, shrank);
+    } else if (value > tree.nodes[node].value) {
+        uint32_t child = deleteRec(tree, rightOf(tree, node), value, shrank);
+        setRight(tree, node, child);
+        updateSize(tree, node);
+        if (shrank) node = rightShrank(tree, node, shrank);
+    } else if (!leftOf(tree, node) || !rightOf(tree, node)) {
+        uint32_t child = leftOf(tree, node) ? leftOf(tree, node) : rightOf(tree, node);
+        freeNode(tree, node);
+        shrank = true;
+        return child;
     } else {
-        // Nó a ser removido encontrado
-        if (!root->left || !root->right) {
-            Node* temp = root->left ? root->left : root->right;
-            delete root;
-            return temp;
+        int successor = tree.nodes[getMinNode(tree, rightOf(tree, node))].value;
+        tree.nodes[node].value = successor;
+        uint32_t child = deleteRec(tree, rightOf(tree, node), successor, shrank);
+        setRight(tree, node, child);
+        updateSize(tree, node);
+        if (shrank) node = rightShrank(tree, node, shrank);
+    }
+
+    return node;
+}
+
+void insertRecursive(AvlTree& tree, int value) {
+    bool grew;
+    tree.root = insertRec(tree, tree.root, value, grew);
+}
+
+void removeRecursive(AvlTree& tree, int value) {
+    bool shrank;
+    tree.root = deleteRec(tree, tree.root, value, shrank);
+}
+
+// Altura de uma subárvore, descendo sempre pelo lado mais alto: O(log n)
+int subtreeHeight(const AvlTree& tree, uint32_t node) {
+    int height = 0;
+    while (node) {
+        height++;
+        node = getBalanceFactor(tree, node) < 0 ? rightOf(tree, node) : leftOf(tree, node);
+    }
+    return height;
+}
+
+// Alturas dos filhos a partir da altura do pai e do fator de balanceamento
+int leftChildHeight(const AvlTree& tree, uint32_t node, int height) {
+    return height - (getBalanceFactor(tree, node) < 0 ? 2 : 1);
+}
+
+int rightChildHeight(const AvlTree& tree, uint32_t node, int height) {
+    return height - (getBalanceFactor(tree, node) > 0 ? 2 : 1);
+}
+
+// Pendura left e right em middle e define o fator de balanceamento
+void linkNode(AvlTree& tree, uint32_t middle, uint32_t left, int leftHeight, uint32_t right, int rightHeight) {
+    tree.nodes[middle].left = left;
+    tree.nodes[middle].right = right;
+    tree.nodes[middle].size = sizeOf(tree, left) + sizeOf(tree, right) + 1;
+    setBalanceFactor(tree, middle, leftHeight - rightHeight);
+}
+
+// Junção (join): devolve uma AVL com left, middle e right, nessa ordem,
+// sabendo que todas as chaves de left < middle < todas as de right. Desce
+// pela borda da árvore mais alta até uma subárvore da altura da outra,
+// pendura middle ali e sobe rebalanceando como numa inserção. Custo
+// O(|altura(left) - altura(right)| + 1); height recebe a nova altura
+uint32_t join(AvlTree& tree, uint32_t left, int leftHeight, uint32_t middle, uint32_t right, int rightHeight,
+              int& height) {
+    if (leftHeight > rightHeight + 1) {
+        // Desce pela borda direita de left; cada nó do caminho ganha middle
+        // e right na sua subárvore
+        AvlPath path;
+        path.depth = 0;
+        uint32_t node = left;
+        int nodeHeight = leftHeight;
+        uint32_t added = sizeOf(tree, right) + 1;
+        while (nodeHeight > rightHeight + 1) {
+            tree.nodes[node].size += added;
+            path.nodes[path.depth] = node;
+            path.wentLeft[path.depth] = false;
+            path.depth++;
+            nodeHeight = rightChildHeight(tree, node, nodeHeight);
+            node = rightOf(tree, node);
         }
+        linkNode(tree, middle, node, nodeHeight, right, rightHeight);
 
-        // Nó com dois filhos
-        Node* temp = getMinNode(root->right);
-        root->value = temp->value;
-        root->right = deleteRec(root->right, temp->value);
+        uint32_t root = left;
+        replaceOnPath(tree, path, path.depth, middle, root);
+        bool grew = true;
+        for (int level = path.depth - 1; level >= 0 && grew; level--) {
+            node = path.nodes[level];
+            uint32_t subtree = rightGrew(tree, node, grew);
+            if (subtree != node) replaceOnPath(tree, path, level, subtree, root);
+        }
+        height = leftHeight + (grew ? 1 : 0);
+        return root;
     }
 
-    // Atualiza a altura do nó
-    root->height = max(getHeight(root->left), getHeight(root->right)) + 1;
+    if (rightHeight > leftHeight + 1) {
+        // Simétrico: desce pela borda esquerda de right
+        AvlPath path;
+        path.depth = 0;
+        uint32_t node = right;
+        int nodeHeight = rightHeight;
+        uint32_t added = sizeOf(tree, left) + 1;
+        while (nodeHeight > leftHeight + 1) {
+            tree.nodes[node].size += added;
+            path.nodes[path.depth] = node;
+            path.wentLeft[path.depth] = true;
+            path.depth++;
+            nodeHeight = leftChildHeight(tree, node, nodeHeight);
+            node = leftOf(tree, node);
+        }
+        linkNode(tree, middle, left, leftHeight, node, nodeHeight);
 
-    // Verifica o fator de balanceamento e faz a rotação necessária
-    int balance = getBalanceFactor(root);
+        uint32_t root = right;
+        replaceOnPath(tree, path, path.depth, middle, root);
+        bool grew = true;
+        for (int level = path.depth - 1; level >= 0 && grew; level--) {
+            node = path.nodes[level];
+            uint32_t subtree = leftGrew(tree, node, grew);
+            if (subtree != node) replaceOnPath(tree, path, level, subtree, root);
+        }
+        height = rightHeight + (grew ? 1 : 0);
+        return root;
+    }
 
-    if (balance > 1 && getBalanceFactor(root->left) >= 0) {
-        return rotateRight(root); // Rotação simples à direita
+    // Alturas próximas: middle vira a raiz
+    linkNode(tree, middle, left, leftHeight, right, rightHeight);
+    height = max(leftHeight, rightHeight) + 1;
+    return middle;
+}
+
+// Subárvore perfeitamente balanceada com values[lo, hi), já ordenados e
+// sem repetição. Os nós são alocados em pré-ordem, então cada subárvore
+// ocupa um trecho contíguo do pool
+uint32_t buildBalanced(AvlTree& tree, const vector<int>& values, size_t lo, size_t hi, int& height) {
+    if (lo == hi) {
+        height = 0;
+        return 0;
     }
-    if (balance > 1 && getBalanceFactor(root->left) < 0) {
-        root->left = rotateLeft(root->left);
-        return rotateRight(root); // Rotação dupla: esquerda-direita
+    size_t mid = lo + (hi - lo) / 2;
+    uint32_t node = newNode(tree, values[mid]);
+    int leftH, rightH;
+    uint32_t left = buildBalanced(tree, values, lo, mid, leftH);
+    uint32_t right = buildBalanced(tree, values, mid + 1, hi, rightH);
+    linkNode(tree, node, left, leftH, right, rightH);
+    height = max(leftH, rightH) + 1;
+    return node;
+}
+
+// Construção em O(n) a partir de valores ordenados e sem repetição; o
+// conteúdo anterior da árvore é descartado
+void bulkLoad(AvlTree& tree, const vector<int>& sorted) {
+    tree = AvlTree();
+    tree.nodes.reserve(sorted.size() + 1);
+    int height;
+    tree.root = buildBalanced(tree, sorted, 0, sorted.size(), height);
+}
+
+// União da subárvore node (de altura height) com values[lo, hi): a chave
+// da raiz separa o lote em duas partes por busca binária, cada parte é
+// unida ao filho correspondente e os resultados são juntados de volta com
+// a própria raiz no meio. Trechos do lote que caem numa subárvore vazia
+// viram subárvores balanceadas de uma vez
+uint32_t unionSorted(AvlTree& tree, uint32_t node, int height, const vector<int>& values, size_t lo, size_t hi,
+                     int& newHeight) {
+    if (lo == hi) {
+        newHeight = height;
+        return node;
     }
-    if (balance < -1 && getBalanceFactor(root->right) <= 0) {
-        return rotateLeft(root); // Rotação simples à esquerda
+    if (!node) return buildBalanced(tree, values, lo, hi, newHeight);
+
+    int key = tree.nodes[node].value;
+    size_t mid = lower_bound(values.begin() + lo, values.begin() + hi, key) - values.begin();
+    size_t next = (mid < hi && values[mid] == key) ? mid + 1 : mid;  // Duplicados são ignorados
+
+    uint32_t left = leftOf(tree, node), right = rightOf(tree, node);
+    int leftH = leftChildHeight(tree, node, height), rightH = rightChildHeight(tree, node, height);
+    left = unionSorted(tree, left, leftH, values, lo, mid, leftH);
+    right = unionSorted(tree, right, rightH, values, next, hi, rightH);
+    return join(tree, left, leftH, node, right, rightH, newHeight);
+}
+
+// Inserção em lote: ordena o lote e o funde à árvore com split/join. Com
+// a árvore vazia é uma construção direta em O(n)
+void insertBatch(AvlTree& tree, vector<int> values) {
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+    if (!tree.root) {
+        bulkLoad(tree, values);
+        return;
     }
-    if (balance < -1 && getBalanceFactor(root->right) > 0) {
-        root->right = rotateRight(root->right);
-        return rotateLeft(root); // Rotação dupla: direita-esquerda
+
+    // Lote pequeno perto do tamanho da árvore: a união visitaria quase os
+    // mesmos caminhos, com mais trabalho por nó. Inserir em ordem aproveita
+    // o trecho do caminho que fica em cache entre chaves vizinhas
+    if (values.size() * 64 < tree.size) {
+        for (int value : values) insert(tree, value);
+        return;
     }
 
-    return root;
+    int height;
+    tree.root = unionSorted(tree, tree.root, subtreeHeight(tree, tree.root), values, 0, values.size(), height);
 }
 
-// Funções auxiliares para percursos
-void preOrder(Node* node) {
+// Separação (split): divide a subárvore root (de altura height) em left,
+// com as chaves menores que key, e right, com as maiores. Devolve o nó com
+// a chave key, já solto das duas partes, ou 0 se ela não estiver lá. Desce
+// guardando o caminho e remonta os dois lados de baixo para cima com join;
+// as alturas das junções sucessivas se telescopam e o custo é O(log n)
+uint32_t split(AvlTree& tree, uint32_t root, int height, int key, uint32_t& left, int& leftHeight,
+               uint32_t& right, int& rightHeight) {
+    AvlPath path;
+    int heights[AVL_MAX_HEIGHT];
+    path.depth = 0;
+    uint32_t node = root;
+    int nodeHeight = height;
+    while (node && tree.nodes[node].value != key) {
+        bool goLeft = key < tree.nodes[node].value;
+        path.nodes[path.depth] = node;
+        path.wentLeft[path.depth] = goLeft;
+        heights[path.depth] = nodeHeight;
+        path.depth++;
+        nodeHeight = goLeft ? leftChildHeight(tree, node, nodeHeight) : rightChildHeight(tree, node, nodeHeight);
+        node = goLeft ? leftOf(tree, node) : rightOf(tree, node);
+    }
+
+    left = right = 0;
+    leftHeight = rightHeight = 0;
     if (node) {
-        cout << node->value << " ";
-        preOrder(node->left);
-        preOrder(node->right);
+        left = leftOf(tree, node);
+        leftHeight = leftChildHeight(tree, node, nodeHeight);
+        right = rightOf(tree, node);
+        rightHeight = rightChildHeight(tree, node, nodeHeight);
+    }
+
+    for (int level = path.depth - 1; level >= 0; level--) {
+        uint32_t parent = path.nodes[level];
+        if (path.wentLeft[level]) {
+            // O pai e a subárvore direita dele ficam acima de key
+            uint32_t sibling = rightOf(tree, parent);
+            int siblingHeight = rightChildHeight(tree, parent, heights[level]);
+            right = join(tree, right, rightHeight, parent, sibling, siblingHeight, rightHeight);
+        } else {
+            uint32_t sibling = leftOf(tree, parent);
+            int siblingHeight = leftChildHeight(tree, parent, heights[level]);
+            left = join(tree, sibling, siblingHeight, parent, left, leftHeight, leftHeight);
+        }
     }
+    return node;
 }
 
-void inOrder(Node* node) {
-    if (node) {
-        inOrder(node->left);
-        cout << node->value << " ";
-        inOrder(node->right);
+// Tira o maior nó da subárvore root e o devolve solto; root e height passam
+// a descrever a subárvore sem ele
+uint32_t splitLast(AvlTree& tree, uint32_t& root, int& height) {
+    AvlPath path;
+    path.depth = 0;
+    uint32_t node = root;
+    while (rightOf(tree, node)) {
+        path.nodes[path.depth] = node;
+        path.wentLeft[path.depth] = false;
+        path.depth++;
+        node = rightOf(tree, node);
     }
+    replaceOnPath(tree, path, path.depth, leftOf(tree, node), root);
+    for (int level = 0; level < path.depth; level++) tree.nodes[path.nodes[level]].size--;
+
+    bool shrank = true;
+    for (int level = path.depth - 1; level >= 0 && shrank; level--) {
+        uint32_t parent = path.nodes[level];
+        uint32_t subtree = rightShrank(tree, parent, shrank);
+        if (subtree != parent) replaceOnPath(tree, path, level, subtree, root);
+    }
+    if (shrank) height--;
+    return node;
 }
 
-void postOrder(Node* node) {
-    if (node) {
-        postOrder(node->left);
-        postOrder(node->right);
-        cout << node->value << " ";
+// Junção sem chave do meio: o maior nó de left faz esse papel
+uint32_t join2(AvlTree& tree, uint32_t left, int leftHeight, uint32_t right, int rightHeight, int& height) {
+    if (!left) {
+        height = rightHeight;
+        return right;
+    }
+    if (!right) {
+        height = leftHeight;
+        return left;
+    }
+    uint32_t middle = splitLast(tree, left, leftHeight);
+    return join(tree, left, leftHeight, middle, right, rightHeight, height);
+}
+
+// Pool de threads para paralelismo fork-join. fork põe a tarefa numa fila
+// comum e join espera por ela executando tarefas da fila enquanto isso:
+// quem espera nunca fica parado diante de uma subtarefa que ninguém pegou.
+// Com uma thread só não há trabalhadores e join executa a própria tarefa
+class ForkJoinPool {
+public:
+    struct Task {
+        function<void()> run;
+        atomic<bool> done;
+    };
+
+    explicit ForkJoinPool(int threads) : stopping(false) {
+        for (int i = 1; i < threads; i++) workers.emplace_back([this] { work(); });
+    }
+
+    ~ForkJoinPool() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (thread& w : workers) w.join();
+    }
+
+    bool parallel() const { return !workers.empty(); }
+
+    void fork(Task& task) {
+        task.done.store(false, memory_order_relaxed);
+        {
+            lock_guard<mutex> lock(queueMutex);
+            queue.push_back(&task);
+        }
+        ready.notify_one();
+    }
+
+    void join(Task& task) {
+        while (!task.done.load(memory_order_acquire)) {
+            Task* other = take();
+            if (other) execute(other);
+            else this_thread::yield();
+        }
+    }
+
+private:
+    vector<thread> workers;
+    vector<Task*> queue;  // pilha: a tarefa mais recente sai primeiro
+    mutex queueMutex;
+    condition_variable ready;
+    bool stopping;
+
+    Task* take() {
+        lock_guard<mutex> lock(queueMutex);
+        if (queue.empty()) return nullptr;
+        Task* task = queue.back();
+        queue.pop_back();
+        return task;
+    }
+
+    static void execute(Task* task) {
+        task->run();
+        task->done.store(true, memory_order_release);
     }
+
+    void work() {
+        while (true) {
+            Task* task;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                ready.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                task = queue.back();
+                queue.pop_back();
+            }
+            execute(task);
+        }
+    }
+};
+
+// Abaixo dessa altura as duas metades de uma operação de conjuntos rodam
+// na mesma thread: o trabalho não paga a passagem pela fila
+const int PARALLEL_MIN_HEIGHT = 12;
+
+// Nós descartados por uma operação de conjuntos. Cada tarefa monta a sua
+// lista (no mesmo formato da lista livre) e as listas são emendadas na
+// volta da recursão, então as threads não disputam tree.freeList
+struct FreeChain {
+    uint32_t head;
+    uint32_t tail;
+};
+
+// Descarta a subárvore node inteira, sem percorrê-la
+void discardSubtree(AvlTree& tree, FreeChain& chain, uint32_t node) {
+    if (!node) return;
+    tree.nodes[node].value = (int)chain.head;
+    chain.head = node;
+    if (!chain.tail) chain.tail = node;
+}
+
+// Descarta só o nó; os filhos dele continuam em uso
+void discardNode(AvlTree& tree, FreeChain& chain, uint32_t node) {
+    tree.nodes[node].left = tree.nodes[node].right = 0;
+    discardSubtree(tree, chain, node);
+}
+
+void appendChain(AvlTree& tree, FreeChain& chain, const FreeChain& other) {
+    if (!other.head) return;
+    if (chain.head) tree.nodes[other.tail].value = (int)chain.head;
+    else chain.tail = other.tail;
+    chain.head = other.head;
 }
 
-// Função para gerar o gráfico em formato Graphviz (DOT)
-void generateGraphviz(Node* node, ofstream& file, int& nodeId) {
-    if (node == nullptr) {
+// Resultado de uma operação de conjuntos sobre duas subárvores. count
+// depende da operação: chaves repetidas na união, chaves mantidas na
+// interseção e chaves removidas na diferença
+struct SetResult {
+    uint32_t root;
+    int height;
+    size_t count;
+    FreeChain discarded;
+};
+
+// Roda left() e right(); quando parallel, left() vai para o pool e pode
+// ser pega por outra thread enquanto esta executa right()
+template <typename Left, typename Right>
+void forkJoin(ForkJoinPool& pool, bool parallel, Left left, Right right) {
+    if (!parallel || !pool.parallel()) {
+        left();
+        right();
         return;
     }
+    ForkJoinPool::Task task;
+    task.run = left;
+    pool.fork(task);
+    right();
+    pool.join(task);
+}
+
+// União por junções: a raiz da árvore mais alta separa a outra com split,
+// as metades são unidas recursivamente (em paralelo) e juntadas de volta
+// com a raiz no meio. O(m log(n/m + 1)) para tamanhos m <= n
+SetResult unionRec(AvlTree& tree, ForkJoinPool& pool, uint32_t a, int aHeight, uint32_t b, int bHeight) {
+    if (!a) return SetResult{b, bHeight, 0, FreeChain{0, 0}};
+    if (!b) return SetResult{a, aHeight, 0, FreeChain{0, 0}};
+    if (aHeight < bHeight) {
+        swap(a, b);
+        swap(aHeight, bHeight);
+    }
+
+    uint32_t lower, upper;
+    int lowerHeight, upperHeight;
+    uint32_t found = split(tree, b, bHeight, tree.nodes[a].value, lower, lowerHeight, upper, upperHeight);
+    uint32_t left = leftOf(tree, a), right = rightOf(tree, a);
+    int leftH = leftChildHeight(tree, a, aHeight), rightH = rightChildHeight(tree, a, aHeight);
+
+    SetResult l, r;
+    forkJoin(pool, min(leftH, lowerHeight) >= PARALLEL_MIN_HEIGHT,
+             [&] { l = unionRec(tree, pool, left, leftH, lower, lowerHeight); },
+             [&] { r = unionRec(tree, pool, right, rightH, upper, upperHeight); });
+
+    SetResult result;
+    result.count = l.count + r.count;
+    result.discarded = l.discarded;
+    appendChain(tree, result.discarded, r.discarded);
+    if (found) {
+        discardNode(tree, result.discarded, found);  // Chave repetida: fica o nó de a
+        result.count++;
+    }
+    result.root = join(tree, l.root, l.height, a, r.root, r.height, result.height);
+    return result;
+}
+
+// Interseção: mesma recursão; a raiz só volta para o resultado se a chave
+// dela estiver nas duas árvores, e o que sobra vai para a lista de descarte
+SetResult intersectionRec(AvlTree& tree, ForkJoinPool& pool, uint32_t a, int aHeight, uint32_t b, int bHeight) {
+    if (!a || !b) {
+        SetResult result{0, 0, 0, FreeChain{0, 0}};
+        discardSubtree(tree, result.discarded, a);
+        discardSubtree(tree, result.discarded, b);
+        return result;
+    }
+    if (aHeight < bHeight) {
+        swap(a, b);
+        swap(aHeight, bHeight);
+    }
 
-    // Cria um nó no formato DOT
-    file << "  node" << nodeId << " [label=\"" << node->value << "\"];\n";
+    uint32_t lower, upper;
+    int lowerHeight, upperHeight;
+    uint32_t found = split(tree, b, bHeight, tree.nodes[a].value, lower, lowerHeight, upper, upperHeight);
+    uint32_t left = leftOf(tree, a), right = rightOf(tree, a);
+    int leftH = leftChildHeight(tree, a, aHeight), rightH = rightChildHeight(tree, a, aHeight);
 
-    // Cria uma variável para o próximo nodeId
-    int nextNodeId = nodeId + 1;
+    SetResult l, r;
+    forkJoin(pool, min(leftH, lowerHeight) >= PARALLEL_MIN_HEIGHT,
+             [&] { l = intersectionRec(tree, pool, left, leftH, lower, lowerHeight); },
+             [&] { r = intersectionRec(tree, pool, right, rightH, upper, upperHeight); });
 
-    // Se houver filho à esquerda, cria a aresta e chama recursivamente
-    if (node->left != nullptr) {
-        file << "  node" << nodeId << " -> node" << nextNodeId << ";\n";
-        generateGraphviz(node->left, file, nextNodeId);
+    SetResult result;
+    result.count = l.count + r.count;
+    result.discarded = l.discarded;
+    appendChain(tree, result.discarded, r.discarded);
+    if (found) {
+        discardNode(tree, result.discarded, found);
+        result.root = join(tree, l.root, l.height, a, r.root, r.height, result.height);
+        result.count++;
+    } else {
+        discardNode(tree, result.discarded, a);
+        result.root = join2(tree, l.root, l.height, r.root, r.height, result.height);
     }
+    return result;
+}
 
-    // Se houver filho à direita, cria a aresta e chama recursivamente
-    if (node->right != nullptr) {
-        file << "  node" << nodeId << " -> node" << nextNodeId << ";\n";
-        generateGraphviz(node->right, file, nextNodeId);
+// Diferença a - b: a raiz de b separa a, as metades são subtraídas
+// recursivamente e juntadas sem chave do meio. Todos os nós de b acabam
+// descartados, a maior parte em subárvores inteiras
+SetResult differenceRec(AvlTree& tree, ForkJoinPool& pool, uint32_t a, int aHeight, uint32_t b, int bHeight) {
+    if (!a || !b) {
+        SetResult result{a, aHeight, 0, FreeChain{0, 0}};
+        discardSubtree(tree, result.discarded, b);
+        return result;
     }
 
-    // Incrementa o nodeId após processar os filhos
-    nodeId = nextNodeId;
+    uint32_t lower, upper;
+    int lowerHeight, upperHeight;
+    uint32_t found = split(tree, a, aHeight, tree.nodes[b].value, lower, lowerHeight, upper, upperHeight);
+    uint32_t left = leftOf(tree, b), right = rightOf(tree, b);
+    int leftH = leftChildHeight(tree, b, bHeight), rightH = rightChildHeight(tree, b, bHeight);
+
+    SetResult l, r;
+    forkJoin(pool, min(leftH, lowerHeight) >= PARALLEL_MIN_HEIGHT,
+             [&] { l = differenceRec(tree, pool, lower, lowerHeight, left, leftH); },
+             [&] { r = differenceRec(tree, pool, upper, upperHeight, right, rightH); });
+
+    SetResult result;
+    result.count = l.count + r.count;
+    result.discarded = l.discarded;
+    appendChain(tree, result.discarded, r.discarded);
+    discardNode(tree, result.discarded, b);
+    if (found) {
+        discardNode(tree, result.discarded, found);
+        result.count++;
+    }
+    result.root = join2(tree, l.root, l.height, r.root, r.height, result.height);
+    return result;
 }
 
+// Passa os nós de other para o pool de tree, para que as duas árvores
+// possam ser combinadas por índices. O pool menor é o copiado (se for o de
+// tree, os vetores são trocados antes), então o custo é linear só no
+// tamanho da árvore menor. treeRoot e otherRoot recebem as raízes no pool
+// combinado; other fica vazia
+void mergePools(AvlTree& tree, AvlTree& other, uint32_t& treeRoot, uint32_t& otherRoot) {
+    treeRoot = tree.root;
+    otherRoot = other.root;
+    bool swapped = other.nodes.size() > tree.nodes.size();
+    if (swapped) {
+        swap(tree.nodes, other.nodes);
+        swap(tree.freeList, other.freeList);
+    }
 
-// Função para gerar o arquivo DOT e salvar o gráfico
-void saveGraphToFile(Node* root, const string& filename) {
-    ofstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo!" << endl;
+    uint32_t offset = tree.nodes.size() - 1;
+    auto shift = [offset](uint32_t link) { return (link & INDEX_MASK) ? link + offset : link; };
+    size_t first = tree.nodes.size();
+    tree.nodes.insert(tree.nodes.end(), other.nodes.begin() + 1, other.nodes.end());
+    for (size_t i = first; i < tree.nodes.size(); i++) {
+        tree.nodes[i].left = shift(tree.nodes[i].left);
+        tree.nodes[i].right = shift(tree.nodes[i].right);
+    }
+
+    // Nas entradas da lista livre copiada o campo value também é um índice
+    uint32_t movedFree = shift(other.freeList);
+    if (movedFree) {
+        uint32_t last = movedFree;
+        while (uint32_t next = shift((uint32_t)tree.nodes[last].value)) {
+            tree.nodes[last].value = (int)next;
+            last = next;
+        }
+        tree.nodes[last].value = (int)tree.freeList;
+        tree.freeList = movedFree;
+    }
+
+    if (swapped) treeRoot = shift(treeRoot);
+    else otherRoot = shift(otherRoot);
+    tree.size += other.size;
+    other = AvlTree();
+}
+
+// Devolve os nós descartados ao pool
+void releaseChain(AvlTree& tree, const FreeChain& chain) {
+    if (!chain.head) return;
+    tree.nodes[chain.tail].value = (int)tree.freeList;
+    tree.freeList = chain.head;
+}
+
+// Operações de conjuntos entre duas árvores: o resultado fica em tree e
+// other termina vazia. threads é o número de threads do pool fork-join
+void setUnion(AvlTree& tree, AvlTree& other, int threads = 1) {
+    if (&tree == &other) return;
+    uint32_t a, b;
+    mergePools(tree, other, a, b);
+    ForkJoinPool pool(threads);
+    SetResult result = unionRec(tree, pool, a, subtreeHeight(tree, a), b, subtreeHeight(tree, b));
+    releaseChain(tree, result.discarded);
+    tree.root = result.root;
+    tree.size -= result.count;
+}
+
+void setIntersection(AvlTree& tree, AvlTree& other, int threads = 1) {
+    if (&tree == &other) return;
+    uint32_t a, b;
+    mergePools(tree, other, a, b);
+    ForkJoinPool pool(threads);
+    SetResult result = intersectionRec(tree, pool, a, subtreeHeight(tree, a), b, subtreeHeight(tree, b));
+    releaseChain(tree, result.discarded);
+    tree.root = result.root;
+    tree.size = result.count;
+}
+
+void setDifference(AvlTree& tree, AvlTree& other, int threads = 1) {
+    if (&tree == &other) {
+        tree = AvlTree();
         return;
     }
+    size_t before = tree.size;
+    uint32_t a, b;
+    mergePools(tree, other, a, b);
+    ForkJoinPool pool(threads);
+    SetResult result = differenceRec(tree, pool, a, subtreeHeight(tree, a), b, subtreeHeight(tree, b));
+    releaseChain(tree, result.discarded);
+    tree.root = result.root;
+    tree.size = before - result.count;
+}
 
-    // Começo do gráfico no formato DOT
-    file << "digraph G {\n";
-    file << "node [shape=circle];\n";  // Definindo o estilo do nó como "circle"
+// Funções auxiliares para percursos (iterativas, ver traversal.h)
+void preOrder(const AvlTree& tree) {
+    preorderVisit(tree.root, AvlLeft{&tree}, AvlRight{&tree}, [&](uint32_t n) { cout << tree.nodes[n].value << " "; });
+}
 
-    int nodeId = 0;  // Inicializa o nodeId
-    generateGraphviz(root, file, nodeId);  // Chama a função para gerar os nós e as arestas
+void inOrder(const AvlTree& tree) {
+    inorderVisit(tree.root, AvlLeft{&tree}, AvlRight{&tree}, [&](uint32_t n) { cout << tree.nodes[n].value << " "; });
+}
 
-    // Fim do gráfico
-    file << "}\n";
-    file.close();
+void postOrder(const AvlTree& tree) {
+    postorderVisit(tree.root, AvlLeft{&tree}, AvlRight{&tree}, [&](uint32_t n) { cout << tree.nodes[n].value << " "; });
+}
 
+// Função para gerar o arquivo DOT e salvar o gráfico (percurso iterativo,
+// sem risco de estourar a pilha em árvores degeneradas)
+void saveGraphToFile(const AvlTree& tree, const string& filename) {
+    bool saved;
+    if (tree.root) {
+        auto children = [&tree](uint32_t node, auto visit) {
+            if (leftOf(tree, node)) visit(leftOf(tree, node));
+            if (rightOf(tree, node)) visit(rightOf(tree, node));
+        };
+        auto label = [&tree](uint32_t node, DotWriter& out) { out << tree.nodes[node].value; };
+        saved = saveGraphviz(filename, tree.root, children, label).written;
+    } else {
+        saved = saveEmptyGraphviz(filename);
+    }
+
+    if (!saved) {
+        cerr << "Erro ao abrir o arquivo!" << endl;
+        return;
+    }
     cout << "Árvore gerada no formato Graphviz em " << filename << endl;
 }
 
+// Função auxiliar para medir o tempo decorrido em segundos
+double elapsedSeconds(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Árvore com n chaves aleatórias distintas; as chaves são devolvidas em keys
+void buildRandomTree(AvlTree& tree, int n, mt19937& rng, vector<int>& keys) {
+    keys.clear();
+    while ((int)tree.size < n) {
+        int value = rng();
+        size_t before = tree.size;
+        insert(tree, value);
+        if (tree.size != before) keys.push_back(value);
+    }
+}
+
+// Percursos iterativos x recursivos em árvores AVL com chaves aleatórias
+void benchmarkTraversal() {
+    const int sizes[] = {1000, 100000, 1000000};
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        AvlTree tree;
+        vector<int> keys;
+        buildRandomTree(tree, n, rng, keys);
+        // A altura da AVL é O(log n): a versão recursiva pode rodar sempre
+        auto value = [&tree](uint32_t node) { return tree.nodes[node].value; };
+        reportTraversalTimes("AVL aleatória", tree.root, AvlLeft{&tree}, AvlRight{&tree}, value, tree.size, true);
+    }
+}
+
+// Buscas por segundo e bytes por nó do pool, até 10^7 chaves
+void benchmarkPool() {
+    const int sizes[] = {1000000, 10000000};
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        AvlTree tree;
+        vector<int> keys;
+        keys.reserve(n);
+
+        auto start = chrono::steady_clock::now();
+        buildRandomTree(tree, n, rng, keys);
+        double insertTime = elapsedSeconds(start);
+
+        // Buscas de chaves presentes, em ordem aleatória
+        shuffle(keys.begin(), keys.end(), rng);
+        long found = 0;
+        start = chrono::steady_clock::now();
+        for (int key : keys) found += search(tree, key) != 0;
+        double hitTime = elapsedSeconds(start);
+
+        // Buscas de chaves aleatórias (quase todas ausentes)
+        long misses = 0;
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < n; i++) misses += search(tree, rng()) == 0;
+        double missTime = elapsedSeconds(start);
+
+        // Remove metade das chaves
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < n / 2; i++) remove(tree, keys[i]);
+        double removeTime = elapsedSeconds(start);
+
+        double poolBytes = (double)tree.nodes.capacity() * sizeof(Node);
+        cout << "n = " << n
+             << " | inserções: " << n / insertTime / 1e6 << " M/s"
+             << " | buscas (presentes): " << n / hitTime / 1e6 << " M/s"
+             << " | buscas (aleatórias): " << n / missTime / 1e6 << " M/s"
+             << " | remoções: " << (n / 2) / removeTime / 1e6 << " M/s\n"
+             << "  bytes por nó: " << sizeof(Node) << " (pool com folga: " << poolBytes / n << ")"
+             << (found == n && (int)tree.size == n - n / 2 ? "" : " | ERRO: chaves perdidas")
+             << " | ausentes: " << misses << endl;
+    }
+}
+
+// 10^7 inserções e remoções misturadas: iterativas x recursivas, sobre a
+// mesma árvore inicial e a mesma sequência de operações
+void benchmarkMixed() {
+    const int sizes[] = {100000, 1000000};
+    const int operations = 10000000;
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        // Chaves em [0, 2n): metade das operações acerta, e o tamanho fica
+        // perto de n durante todo o teste
+        AvlTree iterative;
+        while ((int)iterative.size < n) insert(iterative, rng() % (2 * n));
+        AvlTree recursive = iterative;
+
+        // Operação codificada como chave * 2 + (1 se inserção)
+        vector<int> ops(operations);
+        for (int& op : ops) op = (int)(rng() % (2 * n)) * 2 + (int)(rng() & 1);
+
+        auto start = chrono::steady_clock::now();
+        for (int op : ops) {
+            if (op & 1) insert(iterative, op >> 1);
+            else remove(iterative, op >> 1);
+        }
+        double iterativeTime = elapsedSeconds(start);
+
+        start = chrono::steady_clock::now();
+        for (int op : ops) {
+            if (op & 1) insertRecursive(recursive, op >> 1);
+            else removeRecursive(recursive, op >> 1);
+        }
+        double recursiveTime = elapsedSeconds(start);
+
+        // As duas versões tomam as mesmas decisões: os pools ficam iguais
+        bool same = iterative.root == recursive.root && iterative.size == recursive.size &&
+                    equal(iterative.nodes.begin(), iterative.nodes.end(), recursive.nodes.begin(),
+                          [](const Node& a, const Node& b) {
+                              return a.value == b.value && a.left == b.left && a.right == b.right &&
+                                     a.size == b.size;
+                          });
+
+        cout << "n ~ " << n << ", " << operations << " operações"
+             << " | iterativa: " << operations / iterativeTime / 1e6 << " M/s"
+             << " | recursiva: " << operations / recursiveTime / 1e6 << " M/s"
+             << (same ? "" : " | ERRO: árvores diferentes") << endl;
+    }
+}
+
+// Construção a partir de chaves ordenadas e inserção em lote, comparadas
+// com inserções uma a uma (iterativa e recursiva)
+void benchmarkBatch() {
+    const int loadSize = 10000000;
+    vector<int> sorted(loadSize);
+    for (int i = 0; i < loadSize; i++) sorted[i] = 2 * i;
+
+    double times[3];
+    size_t sizes[3];
+    for (int method = 0; method < 3; method++) {
+        AvlTree tree;
+        auto start = chrono::steady_clock::now();
+        if (method == 0) {
+            bulkLoad(tree, sorted);
+        } else {
+            for (int value : sorted) {
+                if (method == 1) insert(tree, value);
+                else insertRecursive(tree, value);
+            }
+        }
+        times[method] = elapsedSeconds(start);
+        sizes[method] = tree.size;
+    }
+    cout << "Carga de " << loadSize << " chaves ordenadas"
+         << " | construção direta: " << times[0] << " s"
+         << " | insert: " << times[1] << " s"
+         << " | insertRec: " << times[2] << " s"
+         << (sizes[0] == sizes[1] && sizes[1] == sizes[2] ? "" : " | ERRO: tamanhos diferentes") << endl;
+
+    // Lotes de chaves aleatórias sobre uma árvore com 10^6 chaves
+    mt19937 rng(42);
+    AvlTree base;
+    vector<int> keys;
+    buildRandomTree(base, 1000000, rng, keys);
+
+    const int batchSizes[] = {1000, 10000, 100000, 1000000};
+    for (int m : batchSizes) {
+        vector<int> batch(m);
+        for (int& value : batch) value = rng();
+
+        // Melhor de três rodadas: lotes pequenos levam só alguns milissegundos
+        for (int method = 0; method < 3; method++) times[method] = 1e9;
+        for (int round = 0; round < 3; round++) {
+            for (int method = 0; method < 3; method++) {
+                // Pool já com espaço, para não medir a realocação do vetor
+                AvlTree tree = base;
+                tree.nodes.reserve(base.nodes.size() + m);
+                auto start = chrono::steady_clock::now();
+                if (method == 0) {
+                    insertBatch(tree, batch);
+                } else {
+                    for (int value : batch) {
+                        if (method == 1) insert(tree, value);
+                        else insertRecursive(tree, value);
+                    }
+                }
+                times[method] = min(times[method], elapsedSeconds(start));
+                sizes[method] = tree.size;
+            }
+        }
+        cout << "Lote de " << m << " sobre 10^6"
+             << " | em lote: " << m / times[0] / 1e6 << " M/s"
+             << " | insert: " << m / times[1] / 1e6 << " M/s"
+             << " | insertRec: " << m / times[2] / 1e6 << " M/s"
+             << (sizes[0] == sizes[1] && sizes[1] == sizes[2] ? "" : " | ERRO: tamanhos diferentes") << endl;
+    }
+}
+
+// União, interseção e diferença de duas árvores com 10^7 chaves, com 1, 2,
+// 4 e 8 threads no pool fork-join; no fim, uma árvore pequena contra uma
+// grande mostra o custo O(m log(n/m + 1))
+void benchmarkSetOperations() {
+    const int n = 10000000;
+    mt19937 rng(42);
+
+    // 1,5 * n chaves distintas em ordem aleatória: a fica com as n primeiras
+    // e b com as n últimas, então metade das chaves de b também está em a
+    vector<int> keys;
+    keys.reserve(n + n / 2 + n / 50);
+    for (int i = 0; i < n + n / 2 + n / 50; i++) keys.push_back(rng());
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    shuffle(keys.begin(), keys.end(), rng);
+    vector<int> keysA(keys.begin(), keys.begin() + n), keysB(keys.begin() + n / 2, keys.begin() + n + n / 2);
+    sort(keysA.begin(), keysA.end());
+    sort(keysB.begin(), keysB.end());
+
+    vector<int> expected;
+    size_t expectedSize[3];
+    set_union(keysA.begin(), keysA.end(), keysB.begin(), keysB.end(), back_inserter(expected));
+    expectedSize[0] = expected.size();
+    expected.clear();
+    set_intersection(keysA.begin(), keysA.end(), keysB.begin(), keysB.end(), back_inserter(expected));
+    expectedSize[1] = expected.size();
+    expected.clear();
+    set_difference(keysA.begin(), keysA.end(), keysB.begin(), keysB.end(), back_inserter(expected));
+    expectedSize[2] = expected.size();
+
+    AvlTree baseA, baseB;
+    bulkLoad(baseA, keysA);
+    bulkLoad(baseB, keysB);
+    cout << "|a| = " << baseA.size << ", |b| = " << baseB.size << ", núcleos: " << thread::hardware_concurrency()
+         << endl;
+
+    const char* names[3] = {"união", "interseção", "diferença"};
+    const int threadCounts[] = {1, 2, 4, 8};
+    for (int op = 0; op < 3; op++) {
+        double serialTime = 0;
+        for (int threads : threadCounts) {
+            AvlTree a = baseA, b = baseB;
+            auto start = chrono::steady_clock::now();
+            if (op == 0) setUnion(a, b, threads);
+            else if (op == 1) setIntersection(a, b, threads);
+            else setDifference(a, b, threads);
+            double time = elapsedSeconds(start);
+            if (threads == 1) serialTime = time;
+            cout << names[op] << ", " << threads << " thread(s): " << time << " s"
+                 << " | aceleração: " << serialTime / time << "x"
+                 << (a.size == expectedSize[op] ? "" : " | ERRO: tamanho diferente") << endl;
+        }
+    }
+
+    // a com 10^7 chaves contra b com m chaves
+    const int smallSizes[] = {1000, 100000};
+    for (int m : smallSizes) {
+        vector<int> small(keysB.begin(), keysB.begin() + m);
+        AvlTree smallTree;
+        bulkLoad(smallTree, small);
+        double times[2];
+        for (int op = 0; op < 2; op++) {
+            AvlTree a = baseA, b = smallTree;
+            a.nodes.reserve(a.nodes.size() + m);
+            auto start = chrono::steady_clock::now();
+            if (op == 0) setUnion(a, b);
+            else setDifference(a, b);
+            times[op] = elapsedSeconds(start);
+        }
+        cout << "10^7 com " << m << " chaves | união: " << times[0] * 1e3 << " ms"
+             << " | diferença: " << times[1] * 1e3 << " ms" << endl;
+    }
+}
+
+// Versões por percurso em ordem, O(n), usadas só como comparação no
+// benchmark das consultas de ordem
+size_t rankByWalk(const AvlTree& tree, int value) {
+    size_t count = 0;
+    for (uint32_t node : inorderRange(tree.root, AvlLeft{&tree}, AvlRight{&tree})) {
+        if (tree.nodes[node].value >= value) break;
+        count++;
+    }
+    return count;
+}
+
+uint32_t selectByWalk(const AvlTree& tree, size_t k) {
+    for (uint32_t node : inorderRange(tree.root, AvlLeft{&tree}, AvlRight{&tree})) {
+        if (k-- == 0) return node;
+    }
+    return 0;
+}
+
+size_t countRangeByWalk(const AvlTree& tree, int low, int high) {
+    size_t count = 0;
+    for (uint32_t node : inorderRange(tree.root, AvlLeft{&tree}, AvlRight{&tree})) {
+        int value = tree.nodes[node].value;
+        if (value > high) break;
+        if (value >= low) count++;
+    }
+    return count;
+}
+
+// rankOf, select e countRange pelos tamanhos das subárvores x percurso em
+// ordem, em microssegundos por consulta
+void benchmarkOrderStatistics() {
+    const int sizes[] = {100000, 1000000, 10000000};
+    const int queries = 1000000;
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        vector<int> keys(n);
+        for (int& value : keys) value = rng();
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        AvlTree tree;
+        bulkLoad(tree, keys);
+
+        // Intervalos com cerca de 1% das chaves
+        vector<int> lows(queries), highs(queries);
+        vector<size_t> ks(queries);
+        for (int i = 0; i < queries; i++) {
+            lows[i] = rng();
+            highs[i] = (int)min<long long>(INT32_MAX, (long long)lows[i] + (1LL << 32) / 100);
+            ks[i] = rng() % tree.size;
+        }
+
+        // O percurso visita em média metade da árvore: poucas consultas
+        int walkQueries = max(3, 20000000 / n);
+        double fast[3], walk[3];
+        size_t checksum[2][3] = {{0, 0, 0}, {0, 0, 0}};
+        for (int variant = 0; variant < 2; variant++) {
+            int count = variant == 0 ? queries : walkQueries;
+            double* times = variant == 0 ? fast : walk;
+            size_t* sums = checksum[variant];
+
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < count; i++) sums[0] += variant == 0 ? rankOf(tree, lows[i]) : rankByWalk(tree, lows[i]);
+            times[0] = elapsedSeconds(start) / count * 1e6;
+
+            start = chrono::steady_clock::now();
+            for (int i = 0; i < count; i++) sums[1] += variant == 0 ? select(tree, ks[i]) : selectByWalk(tree, ks[i]);
+            times[1] = elapsedSeconds(start) / count * 1e6;
+
+            start = chrono::steady_clock::now();
+            for (int i = 0; i < count; i++) {
+                sums[2] += variant == 0 ? countRange(tree, lows[i], highs[i]) : countRangeByWalk(tree, lows[i], highs[i]);
+            }
+            times[2] = elapsedSeconds(start) / count * 1e6;
+        }
+
+        // As mesmas primeiras consultas, pelos dois caminhos, para conferir
+        bool same = true;
+        for (int i = 0; i < walkQueries; i++) {
+            same = same && rankOf(tree, lows[i]) == rankByWalk(tree, lows[i]) &&
+                   select(tree, ks[i]) == selectByWalk(tree, ks[i]) &&
+                   countRange(tree, lows[i], highs[i]) == countRangeByWalk(tree, lows[i], highs[i]);
+        }
+
+        const char* names[3] = {"rank", "select", "countRange"};
+        cout << "n = " << tree.size << "\n";
+        for (int q = 0; q < 3; q++) {
+            cout << "  " << names[q] << ": " << fast[q] << " us | percurso: " << walk[q] << " us"
+                 << " | " << walk[q] / fast[q] << "x\n";
+        }
+        cout << (same ? "" : "  ERRO: resultados diferentes\n") << flush;
+    }
+}
+
+// Latência de consultas de intervalo numa AVL com 10^7 chaves, com k de 1
+// a 10^6 resultados, nos dois sentidos; o percurso completo filtrando as
+// chaves, que era a única forma antes dos iteradores, fica como referência
+void benchmarkRangeScan() {
+    const int n = 10000000;
+    mt19937 rng(42);
+    vector<int> keys(n + n / 50);
+    for (int& value : keys) value = rng();
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    keys.resize(n);
+    AvlTree tree;
+    bulkLoad(tree, keys);
+
+    const int counts[] = {1, 10, 100, 10000, 1000000};
+    for (int k : counts) {
+        // Intervalos [keys[i], keys[i + k - 1]], com exatamente k chaves
+        int queries = max(20, min(200000, 20000000 / k));
+        vector<int> starts(queries);
+        for (int& i : starts) i = rng() % (n - k + 1);
+
+        double times[2];
+        long long sums[2] = {0, 0};
+        bool correct = true;
+        for (int direction = 0; direction < 2; direction++) {
+            long long& sum = sums[direction];
+            auto start = chrono::steady_clock::now();
+            for (int i : starts) {
+                long found = 0;
+                if (direction == 0) {
+                    for (uint32_t node : rangeScan(tree, keys[i], keys[i + k - 1])) {
+                        sum += tree.nodes[node].value;
+                        found++;
+                    }
+                } else {
+                    for (uint32_t node : rangeScanReverse(tree, keys[i], keys[i + k - 1])) {
+                        sum += tree.nodes[node].value;
+                        found++;
+                    }
+                }
+                correct = correct && found == k;
+            }
+            times[direction] = elapsedSeconds(start) / queries * 1e6;
+        }
+        // Os dois sentidos veem as mesmas chaves
+        correct = correct && sums[0] == sums[1];
+        cout << "k = " << k << " | crescente: " << times[0] << " us (" << times[0] * 1e3 / k << " ns/chave)"
+             << " | decrescente: " << times[1] << " us" << (correct ? "" : " | ERRO: quantidade errada") << endl;
+    }
+
+    // Referência: percurso em ordem de toda a árvore, guardando só o intervalo
+    int low = keys[n / 2], high = keys[n / 2 + 99];
+    long found = 0;
+    auto start = chrono::steady_clock::now();
+    inorderVisit(tree.root, AvlLeft{&tree}, AvlRight{&tree}, [&](uint32_t node) {
+        int value = tree.nodes[node].value;
+        found += value >= low && value <= high;
+    });
+    cout << "Percurso completo para k = 100: " << elapsedSeconds(start) * 1e6 << " us"
+         << (found == 100 ? "" : " | ERRO: quantidade errada") << endl;
+}
+
+// Submenu com os benchmarks da AVL
+void runBenchmarks() {
+    int choice;
+    cout << "\n1. Percursos: iterativo x recursivo\n2. Pool de nós: buscas por segundo e bytes por nó\n3. Inserções e remoções misturadas: iterativa x recursiva\n4. Construção e inserção em lote\n5. União, interseção e diferença com 1 a 8 threads\n6. Consultas de ordem: tamanhos das subárvores x percurso\n7. Consultas de intervalo com 10^7 chaves\nEscolha um benchmark: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            benchmarkTraversal();
+            break;
+        case 2:
+            benchmarkPool();
+            break;
+        case 3:
+            benchmarkMixed();
+            break;
+        case 4:
+            benchmarkBatch();
+            break;
+        case 5:
+            benchmarkSetOperations();
+            break;
+        case 6:
+            benchmarkOrderStatistics();
+            break;
+        case 7:
+            benchmarkRangeScan();
+            break;
+        default:
+            cout << "Opção inválida.\n";
+    }
+}
+
 int main() {
-    Node* root = nullptr;
+    AvlTree tree;
     int choice, value;
 
     while (true) {
@@ -244,7 +1643,12 @@ int main() {
         cout << "5. Ver Em ordem\n";
         cout << "6. Ver Pos-ordem\n";
         cout << "7. Gerar árvore em formato DOT\n";
-        cout << "8. Sair\n";
+        cout << "8. Posição de um valor (rank)\n";
+        cout << "9. k-ésimo menor valor\n";
+        cout << "10. Contar valores em um intervalo\n";
+        cout << "11. Listar valores em um intervalo\n";
+        cout << "12. Benchmarks\n";
+        cout << "13. Sair\n";
         cout << "Escolha: ";
         cin >> choice;
 
@@ -253,50 +1657,97 @@ int main() {
                 int qtd;
                 cout << "Digite a quantidade de valores a serem inseridos: ";
                 cin >> qtd;
+                if (qtd < 0) {
+                    cout << "Quantidade inválida.\n";
+                    break;
+                }
 
                 cout << "Digite os valores para inserir: ";
-                for (int i = 0; i < qtd; i++) {
-                    int v;
-                    cin >> v;
-                    root = insertRec(root, v);
+                {
+                    vector<int> values(qtd);
+                    for (int i = 0; i < qtd; i++) {
+                        cin >> values[i];
+                    }
+
+                    // Árvore vazia: constrói tudo de uma vez; senão funde o lote
+                    insertBatch(tree, values);
                 }
                 break;
             case 2:
                 cout << "Digite um valor para buscar: ";
                 cin >> value;
-                {
-                    Node* result = search(root, value);
-                    if (result) {
-                        cout << "Valor " << value << " encontrado na árvore.\n";
-                    } else {
-                        cout << "Valor " << value << " não encontrado.\n";
-                    }
+                if (search(tree, value)) {
+                    cout << "Valor " << value << " encontrado na árvore.\n";
+                } else {
+                    cout << "Valor " << value << " não encontrado.\n";
                 }
                 break;
             case 3:
                 cout << "Digite um valor para remover: ";
                 cin >> value;
-                root = deleteRec(root, value);
+                remove(tree, value);
                 break;
             case 4:
                 cout << "Pre-ordem: ";
-                preOrder(root);
+                preOrder(tree);
                 cout << endl;
                 break;
             case 5:
                 cout << "Em ordem: ";
-                inOrder(root);
+                inOrder(tree);
                 cout << endl;
                 break;
             case 6:
                 cout << "Pos-ordem: ";
-                postOrder(root);
+                postOrder(tree);
                 cout << endl;
                 break;
             case 7:
-                saveGraphToFile(root, "tree.dot");  // Gera o arquivo DOT
+                saveGraphToFile(tree, "tree.dot");  // Gera o arquivo DOT
                 break;
             case 8:
+                cout << "Digite um valor: ";
+                cin >> value;
+                cout << rankOf(tree, value) << " valor(es) menores que " << value << ".\n";
+                break;
+            case 9: {
+                size_t k;
+                cout << "Digite k (1 = menor valor): ";
+                cin >> k;
+                uint32_t node = k ? select(tree, k - 1) : 0;
+                if (node) {
+                    cout << "O " << k << "º menor valor é " << tree.nodes[node].value << ".\n";
+                } else {
+                    cout << "A árvore não tem " << k << " valores.\n";
+                }
+                break;
+            }
+            case 10: {
+                int low, high;
+                cout << "Digite o início e o fim do intervalo: ";
+                cin >> low >> high;
+                cout << countRange(tree, low, high) << " valor(es) em [" << low << ", " << high << "].\n";
+                break;
+            }
+            case 11: {
+                int low, high, order;
+                cout << "Digite o início e o fim do intervalo: ";
+                cin >> low >> high;
+                cout << "Ordem (1 = crescente, 2 = decrescente): ";
+                cin >> order;
+                cout << "Valores em [" << low << ", " << high << "]: ";
+                if (order == 2) {
+                    for (uint32_t node : rangeScanReverse(tree, low, high)) cout << tree.nodes[node].value << " ";
+                } else {
+                    for (uint32_t node : rangeScan(tree, low, high)) cout << tree.nodes[node].value << " ";
+                }
+                cout << endl;
+                break;
+            }
+            case 12:
+                runBenchmarks();
+                break;
+            case 13:
                 return 0;
             default:
                 cout << "Opção inválida. Tente novamente.\n";
@@ -304,4 +1755,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,7 +1,9 @@
 #include <iostream>
-#include <queue>
 #include <string>
 #include <fstream>
+#include <vector>
+#include "graphviz.h"
+#include "traversal.h"
 using namespace std;
 
 // Estrutura de nó para a árvore binária
@@ -41,51 +43,27 @@ bool search(Node* node, int value) {
 
 // Função para percorrer a árvore em pré-ordem
 void preorder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    cout << node->value << " ";
-    preorder(node->left);
-    preorder(node->right);
+    preorderVisit(node, [](Node* n) { cout << n->value << " "; });
 }
 
 // Função para percorrer a árvore em ordem
 void inorder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    inorder(node->left);
-    cout << node->value << " ";
-    inorder(node->right);
+    inorderVisit(node, [](Node* n) { cout << n->value << " "; });
 }
 
 // Função para percorrer a árvore em pós-ordem
 void postorder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    postorder(node->left);
-    postorder(node->right);
-    cout << node->value << " ";
+    postorderVisit(node, [](Node* n) { cout << n->value << " "; });
 }
 
 // Função para imprimir a árvore no nível
 void levelOrder(Node* node) {
-    if (node == nullptr) {
-        return;
-    }
-    queue<Node*> q;
-    q.push(node);
-
-    while (!q.empty()) {
-        Node* current = q.front();
-        q.pop();
-
-        cout << current->value << " ";
+    levelOrderVisit(node, [](Node* n) { cout << n->value << " "; });
+}
 
-        if (current->left) q.push(current->left);
-        if (current->right) q.push(current->right);
-    }
+// Libera todos os nós da árvore
+void destroyTree(Node* root) {
+    postorderVisit(root, [](Node* n) { delete n; });
 }
 
 // Função auxiliar para remover o menor valor de uma subárvore
@@ -137,52 +115,74 @@ void printTree(Node* node, int depth = 0) {
     printTree(node->left, depth + 1);
 }
 
-void generateGraphviz(Node* node, ofstream& file, int& nodeId) {
-    if (node == nullptr) {
-        return;
-    }
-
-    // Cria um nó no formato DOT
-    file << "  node" << nodeId << " [label=\"" << node->value << "\"];\n";
-
-    // Cria uma variável para o próximo nodeId
-    int nextNodeId = nodeId + 1;
-
-    // Se houver filho à esquerda, cria a aresta e chama recursivamente
-    if (node->left != nullptr) {
-        file << "  node" << nodeId << " -> node" << nextNodeId << ";\n";
-        generateGraphviz(node->left, file, nextNodeId);
-    }
-
-    // Se houver filho à direita, cria a aresta e chama recursivamente
-    if (node->right != nullptr) {
-        file << "  node" << nodeId << " -> node" << nextNodeId << ";\n";
-        generateGraphviz(node->right, file, nextNodeId);
+// Função para gerar o arquivo DOT e salvar o gráfico (percurso iterativo,
+// sem risco de estourar a pilha em árvores degeneradas)
+void saveGraphToFile(Node* root, const string& filename) {
+    bool saved;
+    if (root) {
+        auto children = [](Node* node, auto visit) {
+            if (node->left) visit(node->left);
+            if (node->right) visit(node->right);
+        };
+        auto label = [](Node* node, DotWriter& out) { out << node->value; };
+        saved = saveGraphviz(filename, root, children, label).written;
+    } else {
+        saved = saveEmptyGraphviz(filename);
     }
 
-    // Incrementa o nodeId após processar os filhos
-    nodeId = nextNodeId;
-}
-// Função para gerar o arquivo DOT e salvar o gráfico
-void saveGraphToFile(Node* root, const string& filename) {
-    ofstream file(filename);
-    if (!file.is_open()) {
+    if (!saved) {
         cerr << "Erro ao abrir o arquivo!" << endl;
         return;
     }
+    cout << "Árvore gerada no formato Graphviz em " << filename << endl;
+}
 
-    // Começo do gráfico no formato DOT
-    file << "digraph G {\n";
-    file << "node [shape=circle];\n";  // Definindo o estilo do nó como "circle"
+// Árvore completa com n nós, ligados como numa heap (filhos 2i+1 e 2i+2)
+Node* buildComplete(int n) {
+    vector<Node*> nodes(n);
+    for (int i = 0; i < n; i++) nodes[i] = new Node{i, nullptr, nullptr};
+    for (int i = 0; i < n; i++) {
+        if (2 * i + 1 < n) nodes[i]->left = nodes[2 * i + 1];
+        if (2 * i + 2 < n) nodes[i]->right = nodes[2 * i + 2];
+    }
+    return n ? nodes[0] : nullptr;
+}
 
-    int nodeId = 0;  // Inicializa o nodeId
-    generateGraphviz(root, file, nodeId);  // Chama a função para gerar os nós e as arestas
+// A forma que insert produz com n valores: uma espinha à esquerda com uma
+// folha à direita em cada nível. Montada diretamente, já que cada insert
+// percorre a espinha inteira
+Node* buildLeftSpine(int n) {
+    Node* root = new Node{0, nullptr, nullptr};
+    Node* spine = root;
+    for (int value = 1; value < n; value++) {
+        Node* node = new Node{value, nullptr, nullptr};
+        if (!spine->left) {
+            spine->left = node;
+        } else {
+            spine->right = node;
+            spine = spine->left;
+        }
+    }
+    return root;
+}
 
-    // Fim do gráfico
-    file << "}\n";
-    file.close();
+// Percursos iterativos x recursivos na árvore completa e na espinha
+void benchmarkTraversal() {
+    const int sizes[] = {1000, 100000, 1000000};
+    for (int n : sizes) {
+        Node* root = buildComplete(n);
+        reportTraversalTimes("Árvore completa", root, n, true);
+        destroyTree(root);
+    }
 
-    cout << "Árvore gerada no formato Graphviz em " << filename << endl;
+    // Com 10^6 nós a espinha tem meio milhão de níveis: a recursão
+    // estouraria a pilha de chamadas
+    const int spineSizes[] = {10000, 1000000};
+    for (int n : spineSizes) {
+        Node* root = buildLeftSpine(n);
+        reportTraversalTimes("Árvore em espinha", root, n, n <= 10000);
+        destroyTree(root);
+    }
 }
 
 int main() {
@@ -190,7 +190,7 @@ int main() {
     int choice, key;
 
     while (true) {
-        cout << "\n1. Inserir\n2. Remover\n3. Buscar\n4. Percurso Pré-Ordem\n5. Percurso Em Ordem\n6. Percurso Pós-Ordem\n7. Percurso Nível\n8. Imprimir Árvore\n9. Gerar Grafo\n10. Sair\nEscolha uma opção: ";
+        cout << "\n1. Inserir\n2. Remover\n3. Buscar\n4. Percurso Pré-Ordem\n5. Percurso Em Ordem\n6. Percurso Pós-Ordem\n7. Percurso Nível\n8. Imprimir Árvore\n9. Gerar Grafo\n10. Benchmark de Percursos\n11. Sair\nEscolha uma opção: ";
         cin >> choice;
 
         switch (choice) {
@@ -248,6 +248,9 @@ int main() {
                 saveGraphToFile(root, "tree.dot");
                 break;
             case 10:
+                benchmarkTraversal();
+                break;
+            case 11:
                 cout << "Saindo...\n";
                 return 0;
             default:
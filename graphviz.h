@@ -0,0 +1,193 @@
+#ifndef GRAPHVIZ_H
+#define GRAPHVIZ_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+// Exportação Graphviz (DOT) usada por todas as estruturas. O percurso é em
+// pré-ordem com uma pilha explícita no heap, então árvores degeneradas não
+// estouram a pilha de chamadas, e a saída passa por um buffer próprio
+// gravado em blocos com fwrite. A pilha guarda só os irmãos pendentes ao
+// longo do caminho atual: numa árvore binária degenerada ela não passa de
+// dois nós. Limites opcionais de profundidade e de número de nós cortam a
+// exportação de árvores grandes. Erros de gravação (disco cheio, por
+// exemplo) são detectados no fwrite e no fclose e aparecem no resultado.
+
+// Saída bufferizada para o arquivo DOT; failed fica ligado se alguma
+// gravação não foi completa
+class DotWriter {
+public:
+    explicit DotWriter(FILE* output) : file(output), used(0), failed(false) {}
+    ~DotWriter() { flush(); }
+
+    void write(const char* data, size_t length) {
+        if (used + length > sizeof(buffer)) {
+            flush();
+            if (length > sizeof(buffer)) {
+                if (fwrite(data, 1, length, file) != length) failed = true;
+                return;
+            }
+        }
+        memcpy(buffer + used, data, length);
+        used += length;
+    }
+
+    // Texto de rótulo, com aspas e barras escapadas
+    void writeEscaped(const char* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            if (data[i] == '"' || data[i] == '\\') *this << '\\';
+            *this << data[i];
+        }
+    }
+
+    void flush() {
+        if (used && fwrite(buffer, 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+    bool ok() const { return !failed; }
+
+    DotWriter& operator<<(char ch) {
+        if (used == sizeof(buffer)) flush();
+        buffer[used++] = ch;
+        return *this;
+    }
+
+    DotWriter& operator<<(const char* text) {
+        write(text, strlen(text));
+        return *this;
+    }
+
+    DotWriter& operator<<(const std::string& text) {
+        write(text.data(), text.size());
+        return *this;
+    }
+
+    // Inteiros sem passar por iostream
+    template <typename Integer, typename = typename std::enable_if<std::is_integral<Integer>::value>::type>
+    DotWriter& operator<<(Integer value) {
+        char digits[24];
+        int length = 0;
+        bool negative = value < 0;
+        unsigned long long magnitude = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+        do {
+            digits[length++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        if (negative) digits[length++] = '-';
+
+        while (length) *this << digits[--length];
+        return *this;
+    }
+
+private:
+    FILE* file;
+    char buffer[1 << 16];
+    size_t used;
+    bool failed;
+};
+
+// Limites da exportação (-1 = sem limite); a raiz tem profundidade 0
+struct GraphvizLimits {
+    int maxDepth;
+    long maxNodes;
+
+    GraphvizLimits(int depth = -1, long nodes = -1) : maxDepth(depth), maxNodes(nodes) {}
+};
+
+struct GraphvizResult {
+    bool opened;
+    bool written;       // arquivo aberto e gravado por inteiro
+    long nodes;         // nós gravados
+    size_t maxPending;  // maior tamanho da pilha explícita
+    bool truncated;     // algum limite cortou a exportação
+};
+
+// Grava a árvore que começa em root no arquivo. Handle identifica um nó
+// (ponteiro, índice ou uma pequena struct). children(h, visit) chama
+// visit(filho) para cada filho, em ordem; label(h, out) escreve o rótulo
+// do nó e edgeAttributes(h, out) pode escrever atributos da aresta que
+// chega ao nó (por exemplo " [label=\"a\"]"). Retorna opened = false se o
+// arquivo não puder ser criado e written = false se, além disso, a
+// gravação ou o fechamento falhar.
+template <typename Handle, typename Children, typename Label, typename EdgeAttributes>
+GraphvizResult saveGraphviz(const std::string& filename, const Handle& root, Children children, Label label,
+                            EdgeAttributes edgeAttributes, GraphvizLimits limits) {
+    GraphvizResult result = {false, false, 0, 0, false};
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file) return result;
+    result.opened = true;
+
+    struct Pending {
+        Handle node;
+        long parentId;
+        int depth;
+    };
+    std::vector<Pending> pending(1, Pending{root, -1, 0});
+    std::vector<Handle> siblings;
+
+    {
+        DotWriter out(file);
+        out << "digraph G {\nnode [shape=circle];\n";
+
+        while (!pending.empty()) {
+            if (limits.maxNodes >= 0 && result.nodes == limits.maxNodes) {
+                result.truncated = true;
+                break;
+            }
+
+            Pending current = pending.back();
+            pending.pop_back();
+
+            long id = result.nodes++;
+            out << "  node" << id << " [label=\"";
+            label(current.node, out);
+            out << "\"]\n";
+            if (current.parentId >= 0) {
+                out << "  node" << current.parentId << " -> node" << id;
+                edgeAttributes(current.node, out);
+                out << '\n';
+            }
+
+            // Filhos empilhados ao contrário para sair na ordem original
+            siblings.clear();
+            children(current.node, [&](const Handle& child) { siblings.push_back(child); });
+            if (limits.maxDepth >= 0 && current.depth == limits.maxDepth) {
+                if (!siblings.empty()) result.truncated = true;
+                continue;
+            }
+            for (size_t i = siblings.size(); i-- > 0;) {
+                pending.push_back(Pending{siblings[i], id, current.depth + 1});
+            }
+            if (pending.size() > result.maxPending) result.maxPending = pending.size();
+        }
+
+        if (result.truncated) out << "  // exportação cortada pelo limite de profundidade ou de nós\n";
+        out << "}\n";
+        out.flush();
+        result.written = out.ok();
+    }
+
+    if (fclose(file) != 0) result.written = false;
+    return result;
+}
+
+// Grafo sem nós, para estruturas vazias; false se não foi gravado
+inline bool saveEmptyGraphviz(const std::string& filename) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file) return false;
+    bool written = fputs("digraph G {\nnode [shape=circle];\n}\n", file) >= 0;
+    return fclose(file) == 0 && written;
+}
+
+// Versão sem atributos nas arestas
+template <typename Handle, typename Children, typename Label>
+GraphvizResult saveGraphviz(const std::string& filename, const Handle& root, Children children, Label label,
+                            GraphvizLimits limits = GraphvizLimits()) {
+    return saveGraphviz(filename, root, children, label, [](const Handle&, DotWriter&) {}, limits);
+}
+
+#endif
@@ -1,207 +1,1206 @@
 #include <iostream>
-#include <queue>
 #include <vector>
 #include <string>
 #include <fstream>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <climits>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "graphviz.h"
 using namespace std;
 
-// Estrutura de nó para a árvore Heap
-struct Node {
-    int value;
-    Node* left;
-    Node* right;
+// A heap é armazenada de forma implícita em um vetor contíguo. Numa heap
+// d-ária (Arity = 2, 4 ou 8) os filhos do índice i ficam em
+// Arity*i+1 .. Arity*i+Arity e o pai em (i-1)/Arity.
+
+// Alocador que posiciona o elemento de índice 1 no início de uma linha de
+// cache. Como o bloco de filhos de qualquer nó começa em Arity*i+1, os
+// Arity filhos ficam sempre dentro de uma mesma linha (para Arity <= 16).
+template <typename T>
+struct CacheLineAllocator {
+    typedef T value_type;
+    static const size_t LINE_SIZE = 64;
+
+    CacheLineAllocator() {}
+    template <typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        char* base = static_cast<char*>(::operator new(n * sizeof(T) + LINE_SIZE, align_val_t(LINE_SIZE)));
+        return reinterpret_cast<T*>(base + LINE_SIZE - sizeof(T));
+    }
+
+    void deallocate(T* p, size_t) {
+        char* base = reinterpret_cast<char*>(p) - (LINE_SIZE - sizeof(T));
+        ::operator delete(base, align_val_t(LINE_SIZE));
+    }
 };
 
-// Função auxiliar para criar um novo nó
-Node* createNode(int value) {
-    return new Node{value, nullptr, nullptr};
-}
+template <typename T, typename U>
+bool operator==(const CacheLineAllocator<T>&, const CacheLineAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const CacheLineAllocator<T>&, const CacheLineAllocator<U>&) { return false; }
+
+typedef vector<int, CacheLineAllocator<int>> HeapStorage;
 
 // Função auxiliar para comparar valores (para Max-Heap e Min-Heap)
 bool compare(int a, int b, bool isMinHeap) {
     return isMinHeap ? a < b : a > b;
 }
 
+// As rotinas abaixo são templates sobre o comparador (less<int> para
+// Min-Heap, greater<int> para Max-Heap), de modo que os laços de
+// heapify não testam o tipo da heap a cada comparação.
+
+// Escolhe o filho extremo entre Arity filhos consecutivos. O laço não tem
+// dependência entre iterações além do índice escolhido e o compilador
+// consegue vetorizá-lo; para less/greater há versões SSE2 abaixo.
+template <int Arity, typename Compare>
+struct ChildSelector {
+    static int select(const int* children, Compare comp) {
+        int best = 0;
+        for (int k = 1; k < Arity; k++) {
+            if (comp(children[k], children[best])) best = k;
+        }
+        return best;
+    }
+};
+
+#ifdef __SSE2__
+// Mínimo (ou máximo) horizontal de 4 inteiros, replicado nas 4 posições
+template <bool IsMin>
+inline __m128i extreme4(__m128i a, __m128i b) {
+    __m128i mask = IsMin ? _mm_cmplt_epi32(a, b) : _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+template <bool IsMin>
+inline __m128i horizontalExtreme(__m128i v) {
+    v = extreme4<IsMin>(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return extreme4<IsMin>(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+// Índice do primeiro filho igual ao extremo (mesmo desempate da versão escalar)
+inline int firstMatch(__m128i v, __m128i target) {
+    return __builtin_ctz(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, target))));
+}
+
+template <bool IsMin>
+inline int selectChild4(const int* children) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(children));
+    return firstMatch(v, horizontalExtreme<IsMin>(v));
+}
+
+template <bool IsMin>
+inline int selectChild8(const int* children) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(children));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(children + 4));
+    __m128i target = horizontalExtreme<IsMin>(extreme4<IsMin>(low, high));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, target))) |
+               _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(high, target))) << 4;
+    return __builtin_ctz(mask);
+}
+
+template <>
+struct ChildSelector<4, less<int>> {
+    static int select(const int* children, less<int>) { return selectChild4<true>(children); }
+};
+
+template <>
+struct ChildSelector<4, greater<int>> {
+    static int select(const int* children, greater<int>) { return selectChild4<false>(children); }
+};
+
+template <>
+struct ChildSelector<8, less<int>> {
+    static int select(const int* children, less<int>) { return selectChild8<true>(children); }
+};
+
+template <>
+struct ChildSelector<8, greater<int>> {
+    static int select(const int* children, greater<int>) { return selectChild8<false>(children); }
+};
+#endif
+
 // Função auxiliar para fazer o "heapify-down"
-void heapifyDown(Node* node, bool isMinHeap) {
-    if (!node || (!node->left && !node->right)) return;
+template <int Arity = 2, typename Compare>
+void heapifyDown(HeapStorage& heap, int index, Compare comp) {
+    int size = heap.size();
+    int value = heap[index];
 
-    Node* extreme = node;
+    // Desce um "buraco" até a posição final e só então grava o valor
+    while (true) {
+        int first = Arity * index + 1;
+        if (first >= size) break;
 
-    if (node->left && compare(node->left->value, extreme->value, isMinHeap)) {
-        extreme = node->left;
-    }
+        int child;
+        if (first + Arity <= size) {
+            child = first + ChildSelector<Arity, Compare>::select(&heap[first], comp);
+        } else {
+            // Último nó interno pode ter menos de Arity filhos
+            child = first;
+            for (int k = first + 1; k < size; k++) {
+                if (comp(heap[k], heap[child])) child = k;
+            }
+        }
 
-    if (node->right && compare(node->right->value, extreme->value, isMinHeap)) {
-        extreme = node->right;
-    }
+        if (!comp(heap[child], value)) break;
 
-    if (extreme != node) {
-        swap(node->value, extreme->value);
-        heapifyDown(extreme, isMinHeap);
+        heap[index] = heap[child];
+        index = child;
     }
+
+    heap[index] = value;
 }
 
 // Função auxiliar para fazer o "heapify-up"
-void heapifyUp(vector<int>& heap, int index, bool isMinHeap) {
+template <int Arity = 2, typename Compare>
+void heapifyUp(HeapStorage& heap, int index, Compare comp) {
+    int value = heap[index];
+
     while (index > 0) {
-        int parentIndex = (index - 1) / 2;
-        if (compare(heap[index], heap[parentIndex], isMinHeap)) {
-            swap(heap[index], heap[parentIndex]);
+        int parentIndex = (index - 1) / Arity;
+        if (comp(value, heap[parentIndex])) {
+            heap[index] = heap[parentIndex];
             index = parentIndex;
         } else {
             break;
         }
     }
+
+    heap[index] = value;
 }
 
 // Inserir na Heap
-Node* insert(Node* root, int value, queue<Node*>& nodes, bool isMinHeap) {
-    Node* newNode = createNode(value);
+template <int Arity = 2, typename Compare>
+void insert(HeapStorage& heap, int value, Compare comp) {
+    heap.push_back(value);
+    heapifyUp<Arity>(heap, heap.size() - 1, comp);
+}
+
+// Remover o extremo (menor no Min-Heap ou maior no Max-Heap)
+template <int Arity = 2, typename Compare>
+void removeExtreme(HeapStorage& heap, Compare comp) {
+    if (heap.empty()) return;
+
+    // Substituir a raiz pelo último elemento
+    heap[0] = heap.back();
+    heap.pop_back();
 
-    if (!root) {
-        nodes.push(newNode);
-        return newNode;
+    // Reequilibrar a heap
+    if (!heap.empty()) {
+        heapifyDown<Arity>(heap, 0, comp);
     }
+}
+
+// Função auxiliar para fazer heapify em todo o vetor
+template <int Arity = 2, typename Compare>
+void heapify(HeapStorage& heap, Compare comp) {
+    if (heap.size() < 2) return;
 
-    // Inserção no nó disponível da fila
-    Node* parent = nodes.front();
-    if (!parent->left) {
-        parent->left = newNode;
-    } else if (!parent->right) {
-        parent->right = newNode;
-        nodes.pop(); // Remove o nó que já tem dois filhos
+    // Realiza heapify-down a partir do último nó interno até a raiz
+    for (int i = ((int)heap.size() - 2) / Arity; i >= 0; i--) {
+        heapifyDown<Arity>(heap, i, comp);
     }
+}
 
-    nodes.push(newNode); // Adiciona o novo nó à fila
+// Construção em lote: copia os valores para o vetor e aplica o heapify
+// de baixo para cima (Floyd), em O(n) em vez de O(n log n) inserções
+template <int Arity = 2, typename Compare>
+void buildHeap(HeapStorage& heap, const vector<int>& values, Compare comp) {
+    heap.assign(values.begin(), values.end());
+    heapify<Arity>(heap, comp);
+}
 
-    return root;
+// Inserção em lote: acrescenta os valores no fim do vetor e refaz o
+// heapify apenas nos ancestrais das novas posições, nível a nível. O custo
+// é O(m + log n) heapify-downs para m valores, em vez de m heapify-ups.
+template <int Arity = 2, typename Compare>
+void pushBatch(HeapStorage& heap, const vector<int>& values, Compare comp) {
+    if (values.empty()) return;
+
+    int low = heap.size();
+    heap.insert(heap.end(), values.begin(), values.end());
+    int high = heap.size() - 1;
+
+    // Os intervalos de pais de posições consecutivas também são consecutivos
+    while (high > 0) {
+        low = (low - 1) / Arity;
+        high = (high - 1) / Arity;
+        for (int i = high; i >= low; i--) {
+            heapifyDown<Arity>(heap, i, comp);
+        }
+    }
 }
 
-// Remover o extremo (menor no Min-Heap ou maior no Max-Heap)
-Node* removeExtreme(Node* root, bool isMinHeap) {
-    if (!root) return nullptr;
+// Remoção em lote: grava em out até k extremos, do melhor para o pior.
+// Para k grande em relação a n é mais barato particionar o vetor inteiro,
+// ordenar só os k escolhidos e reconstruir o restante em O(n).
+template <int Arity = 2, typename Compare>
+void popBatch(HeapStorage& heap, int k, vector<int>& out, Compare comp) {
+    int size = heap.size();
+    k = min(k, size);
+    if (k <= 0) return;
 
-    if (!root->left && !root->right) {
-        delete root;
-        return nullptr;
+    double popCost = (double)k * log2(size + 1);
+    if (popCost < 2.0 * size) {
+        for (int i = 0; i < k; i++) {
+            out.push_back(heap[0]);
+            removeExtreme<Arity>(heap, comp);
+        }
+        return;
     }
 
-    // Encontrar o nó mais à direita na última camada
-    queue<Node*> q;
-    q.push(root);
-    Node* lastNode = nullptr;
-    Node* parent = nullptr;
+    nth_element(heap.begin(), heap.begin() + (k - 1), heap.end(), comp);
+    sort(heap.begin(), heap.begin() + k, comp);
+    out.insert(out.end(), heap.begin(), heap.begin() + k);
 
-    while (!q.empty()) {
-        lastNode = q.front();
-        q.pop();
+    heap.erase(heap.begin(), heap.begin() + k);
+    heapify<Arity>(heap, comp);
+}
 
-        if (lastNode->left) {
-            parent = lastNode;
-            q.push(lastNode->left);
-        }
+// Troca a raiz por um novo valor e reequilibra (uma remoção + inserção)
+template <int Arity = 2, typename Compare>
+void replaceTop(HeapStorage& heap, int value, Compare comp) {
+    heap[0] = value;
+    heapifyDown<Arity>(heap, 0, comp);
+}
+
+// Top-k em fluxo: mantém os k valores que ficariam por último na ordem de
+// comp (os k maiores numa Min-Heap). A raiz é o pior dos k mantidos e só
+// é substituída quando chega um valor melhor que ela.
+template <int Arity = 2, typename Compare>
+void pushTopK(HeapStorage& heap, int value, int k, Compare comp) {
+    if ((int)heap.size() < k) {
+        insert<Arity>(heap, value, comp);
+    } else if (k > 0 && comp(heap[0], value)) {
+        replaceTop<Arity>(heap, value, comp);
+    }
+}
+
+// Chama op(integral_constant<int, Arity>(), comparador) com o tipo e a
+// aridade escolhidos em tempo de execução
+template <typename Operation>
+void dispatchHeap(bool isMinHeap, int arity, Operation op) {
+    switch (arity) {
+        case 4:
+            if (isMinHeap) op(integral_constant<int, 4>(), less<int>());
+            else op(integral_constant<int, 4>(), greater<int>());
+            break;
+        case 8:
+            if (isMinHeap) op(integral_constant<int, 8>(), less<int>());
+            else op(integral_constant<int, 8>(), greater<int>());
+            break;
+        default:
+            if (isMinHeap) op(integral_constant<int, 2>(), less<int>());
+            else op(integral_constant<int, 2>(), greater<int>());
+    }
+}
+
+// Versões com o tipo e a aridade da heap escolhidos em tempo de execução:
+// apenas despacham para a especialização correspondente do template
+void heapifyDown(HeapStorage& heap, int index, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { heapifyDown<decltype(a)::value>(heap, index, comp); });
+}
+
+void heapifyUp(HeapStorage& heap, int index, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { heapifyUp<decltype(a)::value>(heap, index, comp); });
+}
+
+void insert(HeapStorage& heap, int value, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { insert<decltype(a)::value>(heap, value, comp); });
+}
+
+void removeExtreme(HeapStorage& heap, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { removeExtreme<decltype(a)::value>(heap, comp); });
+}
+
+void heapify(HeapStorage& heap, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { heapify<decltype(a)::value>(heap, comp); });
+}
 
-        if (lastNode->right) {
-            parent = lastNode;
-            q.push(lastNode->right);
+void buildHeap(HeapStorage& heap, const vector<int>& values, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { buildHeap<decltype(a)::value>(heap, values, comp); });
+}
+
+void pushBatch(HeapStorage& heap, const vector<int>& values, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { pushBatch<decltype(a)::value>(heap, values, comp); });
+}
+
+void popBatch(HeapStorage& heap, int k, vector<int>& out, bool isMinHeap, int arity = 2) {
+    dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) { popBatch<decltype(a)::value>(heap, k, out, comp); });
+}
+
+// Heap indexada: cada valor inserido recebe um identificador estável
+// (handle) que permite alterar a prioridade ou remover o item depois,
+// sem inserir duplicatas. A chave é guardada junto do handle na própria
+// heap para que as comparações não precisem de indireção.
+struct IndexedEntry {
+    int key;
+    int handle;
+};
+
+struct IndexedHeap {
+    vector<IndexedEntry> entries;  // entradas em ordem de heap
+    vector<int> position;          // posição de cada handle (-1 se fora da heap)
+    vector<int> freeHandles;       // handles liberados para reuso
+};
+
+// Grava a entrada na posição e atualiza o índice do handle
+inline void placeEntry(IndexedHeap& h, int index, const IndexedEntry& entry) {
+    h.entries[index] = entry;
+    h.position[entry.handle] = index;
+}
+
+// Função auxiliar para fazer o "heapify-up" na heap indexada
+template <int Arity = 2, typename Compare>
+void heapifyUp(IndexedHeap& h, int index, Compare comp) {
+    IndexedEntry entry = h.entries[index];
+
+    while (index > 0) {
+        int parentIndex = (index - 1) / Arity;
+        if (!comp(entry.key, h.entries[parentIndex].key)) break;
+
+        placeEntry(h, index, h.entries[parentIndex]);
+        index = parentIndex;
+    }
+
+    placeEntry(h, index, entry);
+}
+
+// Função auxiliar para fazer o "heapify-down" na heap indexada
+template <int Arity = 2, typename Compare>
+void heapifyDown(IndexedHeap& h, int index, Compare comp) {
+    int size = h.entries.size();
+    IndexedEntry entry = h.entries[index];
+
+    while (true) {
+        int first = Arity * index + 1;
+        if (first >= size) break;
+
+        int child = first;
+        int last = min(first + Arity, size);
+        for (int k = first + 1; k < last; k++) {
+            if (comp(h.entries[k].key, h.entries[child].key)) child = k;
         }
+
+        if (!comp(h.entries[child].key, entry.key)) break;
+
+        placeEntry(h, index, h.entries[child]);
+        index = child;
     }
 
-    // Substituir a raiz pelo último nó
-    root->value = lastNode->value;
-    if (parent->right == lastNode) {
-        parent->right = nullptr;
+    placeEntry(h, index, entry);
+}
+
+// Inserir na heap indexada; retorna o handle do novo item
+template <int Arity = 2, typename Compare>
+int insert(IndexedHeap& h, int key, Compare comp) {
+    int handle;
+    if (!h.freeHandles.empty()) {
+        handle = h.freeHandles.back();
+        h.freeHandles.pop_back();
     } else {
-        parent->left = nullptr;
+        handle = h.position.size();
+        h.position.push_back(-1);
     }
 
-    delete lastNode;
+    h.entries.push_back(IndexedEntry{key, handle});
+    heapifyUp<Arity>(h, h.entries.size() - 1, comp);
+    return handle;
+}
 
-    // Reequilibrar a heap
-    heapifyDown(root, isMinHeap);
+// Verifica se o handle ainda está na heap
+bool contains(const IndexedHeap& h, int handle) {
+    return handle >= 0 && handle < (int)h.position.size() && h.position[handle] != -1;
+}
 
-    return root;
+// Prioridade atual de um item
+int keyOf(const IndexedHeap& h, int handle) {
+    return h.entries[h.position[handle]].key;
 }
 
-// Função auxiliar para fazer heapify em toda a árvore
-void heapify(Node* root, bool isMinHeap) {
-    if (!root) return;
+// Remover um item qualquer pelo seu handle
+template <int Arity = 2, typename Compare>
+void erase(IndexedHeap& h, int handle, Compare comp) {
+    if (!contains(h, handle)) return;
+
+    int index = h.position[handle];
+    IndexedEntry last = h.entries.back();
+    h.entries.pop_back();
+    h.position[handle] = -1;
+    h.freeHandles.push_back(handle);
 
-    // Realizar heapify em uma travessia pós-ordem
-    if (root->left) heapify(root->left, isMinHeap);
-    if (root->right) heapify(root->right, isMinHeap);
+    if (index == (int)h.entries.size()) return;
 
-    heapifyDown(root, isMinHeap);
+    // O último elemento ocupa o lugar removido e pode precisar subir ou descer
+    placeEntry(h, index, last);
+    if (index > 0 && comp(last.key, h.entries[(index - 1) / Arity].key)) {
+        heapifyUp<Arity>(h, index, comp);
+    } else {
+        heapifyDown<Arity>(h, index, comp);
+    }
 }
 
-// Percurso em nível
-void levelOrder(Node* node) {
-    if (!node) return;
+// Remover o extremo; retorna o handle removido (-1 se vazia)
+template <int Arity = 2, typename Compare>
+int removeExtreme(IndexedHeap& h, Compare comp) {
+    if (h.entries.empty()) return -1;
 
-    queue<Node*> q;
-    q.push(node);
+    int handle = h.entries[0].handle;
+    erase<Arity>(h, handle, comp);
+    return handle;
+}
 
-    while (!q.empty()) {
-        Node* current = q.front();
-        q.pop();
+// Alterar a prioridade de um item já presente na heap
+template <int Arity = 2, typename Compare>
+void changeKey(IndexedHeap& h, int handle, int key, Compare comp) {
+    if (!contains(h, handle)) return;
 
-        cout << current->value << " ";
+    int index = h.position[handle];
+    int oldKey = h.entries[index].key;
+    h.entries[index].key = key;
 
-        if (current->left) q.push(current->left);
-        if (current->right) q.push(current->right);
+    if (comp(key, oldKey)) {
+        heapifyUp<Arity>(h, index, comp);
+    } else {
+        heapifyDown<Arity>(h, index, comp);
     }
-    cout << endl;
 }
 
-// Função para imprimir a árvore no formato Graphviz
-void generateGraphviz(Node* node, ofstream& file, int& nodeId) {
-    if (!node) return;
+// Diminuir / aumentar a chave de um item (o sentido do movimento depende
+// do comparador: numa Min-Heap diminuir a chave faz o item subir)
+template <int Arity = 2, typename Compare>
+void decreaseKey(IndexedHeap& h, int handle, int key, Compare comp) {
+    if (contains(h, handle) && key < keyOf(h, handle)) {
+        changeKey<Arity>(h, handle, key, comp);
+    }
+}
 
-    file << "  node" << nodeId << " [label=\"" << node->value << "\"]\n";
+template <int Arity = 2, typename Compare>
+void increaseKey(IndexedHeap& h, int handle, int key, Compare comp) {
+    if (contains(h, handle) && key > keyOf(h, handle)) {
+        changeKey<Arity>(h, handle, key, comp);
+    }
+}
+
+// Fila de prioridade concorrente relaxada (MultiQueue): várias sub-heaps,
+// cada uma com sua própria trava. A inserção usa uma sub-heap aleatória e
+// a remoção compara o topo de duas sub-heaps sorteadas e remove do melhor,
+// de modo que nenhuma trava é disputada por todas as threads. Em troca, o
+// item removido é apenas aproximadamente o extremo global.
+struct alignas(64) SubHeap {
+    mutex lock;
+    HeapStorage heap;
+    atomic<int> size{0};
+    atomic<int> top{0};  // cópia do topo, lida sem trava para o sorteio
+};
+
+struct MultiQueue {
+    int queueCount;
+    unique_ptr<SubHeap[]> queues;
+
+    MultiQueue(int count) : queueCount(count), queues(new SubHeap[count]) {}
+};
+
+// Atualiza as cópias de tamanho e topo (chamada com a trava adquirida)
+inline void publishTop(SubHeap& q) {
+    q.size.store(q.heap.size(), memory_order_relaxed);
+    if (!q.heap.empty()) q.top.store(q.heap[0], memory_order_relaxed);
+}
+
+// Inserir em uma sub-heap livre escolhida aleatoriamente
+template <typename Compare>
+void insert(MultiQueue& mq, int value, Compare comp, mt19937& rng) {
+    while (true) {
+        SubHeap& q = mq.queues[rng() % mq.queueCount];
+        if (!q.lock.try_lock()) continue;
+
+        insert(q.heap, value, comp);
+        publishTop(q);
+        q.lock.unlock();
+        return;
+    }
+}
+
+// Remover um extremo aproximado; retorna false se todas as sub-heaps
+// estiverem vazias
+template <typename Compare>
+bool removeExtreme(MultiQueue& mq, int& value, Compare comp, mt19937& rng) {
+    for (int attempt = 0; attempt < 4 * mq.queueCount; attempt++) {
+        SubHeap& a = mq.queues[rng() % mq.queueCount];
+        SubHeap& b = mq.queues[rng() % mq.queueCount];
+
+        // Escolhe a sub-heap com o melhor topo (vazias perdem)
+        int sizeA = a.size.load(memory_order_relaxed);
+        int sizeB = b.size.load(memory_order_relaxed);
+        if (sizeA == 0 && sizeB == 0) continue;
+
+        SubHeap* q = &a;
+        if (sizeA == 0 || (sizeB > 0 && comp(b.top.load(memory_order_relaxed), a.top.load(memory_order_relaxed)))) {
+            q = &b;
+        }
+
+        if (!q->lock.try_lock()) continue;
+        if (q->heap.empty()) {
+            q->lock.unlock();
+            continue;
+        }
+
+        value = q->heap[0];
+        removeExtreme(q->heap, comp);
+        publishTop(*q);
+        q->lock.unlock();
+        return true;
+    }
 
-    int currentNodeId = nodeId;
+    // Sorteios sem sucesso: percorre todas as sub-heaps antes de desistir
+    for (int i = 0; i < mq.queueCount; i++) {
+        SubHeap& q = mq.queues[i];
+        lock_guard<mutex> guard(q.lock);
+        if (q.heap.empty()) continue;
 
-    if (node->left) {
-        file << "  node" << currentNodeId << " -> node" << ++nodeId << "\n";
-        generateGraphviz(node->left, file, nodeId);
+        value = q.heap[0];
+        removeExtreme(q.heap, comp);
+        publishTop(q);
+        return true;
     }
+    return false;
+}
 
-    if (node->right) {
-        file << "  node" << currentNodeId << " -> node" << ++nodeId << "\n";
-        generateGraphviz(node->right, file, nodeId);
+// Percurso em nível
+void levelOrder(const HeapStorage& heap) {
+    // No vetor implícito a ordem dos índices já é a ordem em nível
+    for (int value : heap) {
+        cout << value << " ";
     }
+    cout << endl;
 }
 
-void saveGraphToFile(Node* root, const string& filename) {
-    ofstream file(filename);
-    if (!file.is_open()) {
+// Função para gerar o arquivo DOT da heap; os nós são os índices do vetor
+// e os filhos de i são arity*i+1 .. arity*i+arity
+void saveGraphToFile(const HeapStorage& heap, const string& filename, int arity) {
+    int size = heap.size();
+    bool saved;
+    if (size > 0) {
+        auto children = [&](int i, auto visit) {
+            for (int c = arity * i + 1; c <= arity * i + arity && c < size; c++) visit(c);
+        };
+        auto label = [&](int i, DotWriter& out) { out << heap[i]; };
+        saved = saveGraphviz(filename, 0, children, label).written;
+    } else {
+        saved = saveEmptyGraphviz(filename);
+    }
+
+    if (!saved) {
         cerr << "Erro ao abrir o arquivo!\n";
         return;
     }
+    cout << "Arquivo DOT gerado: " << filename << endl;
+}
 
-    file << "digraph G {\nnode [shape=circle];\n";
+// Função auxiliar para medir o tempo decorrido em segundos
+double elapsedSeconds(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
 
-    int nodeId = 0;
-    generateGraphviz(root, file, nodeId);
+// Mede a vazão de remoções do extremo para heaps de 10^6 a 10^7 elementos
+void benchmarkRemoveExtreme(bool isMinHeap) {
+    const int sizes[] = {1000000, 3000000, 10000000};
+    mt19937 rng(42);
 
-    file << "}\n";
-    file.close();
+    for (int n : sizes) {
+        HeapStorage heap;
+        heap.reserve(n);
 
-    cout << "Arquivo DOT gerado: " << filename << endl;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < n; i++) {
+            insert(heap, rng(), isMinHeap);
+        }
+        double insertTime = elapsedSeconds(start);
+
+        // Confere a ordem das remoções enquanto mede
+        bool ordered = true;
+        int previous = heap[0];
+
+        start = chrono::steady_clock::now();
+        while (!heap.empty()) {
+            if (compare(heap[0], previous, isMinHeap)) ordered = false;
+            previous = heap[0];
+            removeExtreme(heap, isMinHeap);
+        }
+        double removeTime = elapsedSeconds(start);
+
+        cout << "n = " << n
+             << " | inserções: " << n / insertTime / 1e6 << " M/s"
+             << " | remoções: " << n / removeTime / 1e6 << " M/s"
+             << (ordered ? "" : " | ERRO: ordem incorreta") << endl;
+    }
+}
+
+// Comparador que decide o tipo da heap a cada chamada, como a versão antiga
+struct RuntimeCompare {
+    bool isMinHeap;
+
+    bool operator()(int a, int b) const {
+        return compare(a, b, isMinHeap);
+    }
+};
+
+// Mede o custo médio de um heapify-down a partir da raiz (uma remoção)
+template <typename Compare>
+double measureHeapifyDown(const vector<int>& values, Compare comp) {
+    HeapStorage heap(values.begin(), values.end());
+    heapify(heap, comp);
+
+    auto start = chrono::steady_clock::now();
+    while (!heap.empty()) {
+        removeExtreme(heap, comp);
+    }
+    return elapsedSeconds(start) / values.size() * 1e9;
+}
+
+// Compara o heapify-down com o tipo da heap em tempo de execução e o template
+void benchmarkComparator(bool isMinHeap) {
+    const int sizes[] = {1000, 100000, 10000000};
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        vector<int> values(n);
+        for (int& v : values) v = rng();
+
+        // Repete heaps pequenas para ter tempo suficiente de medição
+        int rounds = max(1, 10000000 / n);
+        double runtimeNs = 0, templateNs = 0;
+
+        for (int r = 0; r < rounds; r++) {
+            runtimeNs += measureHeapifyDown(values, RuntimeCompare{isMinHeap});
+            templateNs += isMinHeap ? measureHeapifyDown(values, less<int>())
+                                    : measureHeapifyDown(values, greater<int>());
+        }
+
+        cout << "n = " << n
+             << " | bool em execução: " << runtimeNs / rounds << " ns"
+             << " | template: " << templateNs / rounds << " ns" << endl;
+    }
+}
+
+// Compara a construção em lote com n inserções sucessivas
+void benchmarkBuildHeap(bool isMinHeap) {
+    const int sizes[] = {1000000, 10000000};
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        vector<int> randomValues(n), sortedValues(n);
+        for (int& v : randomValues) v = rng();
+
+        // Entrada ordenada no sentido contrário da heap: pior caso das inserções
+        for (int i = 0; i < n; i++) {
+            sortedValues[i] = isMinHeap ? n - i : i;
+        }
+
+        const vector<int>* inputs[] = {&randomValues, &sortedValues};
+        const char* names[] = {"aleatória", "ordenada"};
+
+        for (int k = 0; k < 2; k++) {
+            const vector<int>& values = *inputs[k];
+            HeapStorage heap;
+
+            auto start = chrono::steady_clock::now();
+            buildHeap(heap, values, isMinHeap);
+            double buildTime = elapsedSeconds(start);
+
+            heap.clear();
+            heap.shrink_to_fit();
+
+            start = chrono::steady_clock::now();
+            for (int v : values) {
+                insert(heap, v, isMinHeap);
+            }
+            double insertTime = elapsedSeconds(start);
+
+            cout << "n = " << n << " (" << names[k] << ")"
+                 << " | buildHeap: " << buildTime * 1e3 << " ms"
+                 << " | inserções: " << insertTime * 1e3 << " ms" << endl;
+        }
+    }
+}
+
+// Mede o custo médio de um par remoção + inserção (modelo "hold") numa
+// heap de tamanho constante
+template <int Arity, typename Compare>
+double measureHold(const vector<int>& values, const vector<int>& updates, int operations, Compare comp) {
+    HeapStorage heap;
+    buildHeap<Arity>(heap, values, comp);
+
+    int mask = updates.size() - 1;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < operations; i++) {
+        removeExtreme<Arity>(heap, comp);
+        insert<Arity>(heap, updates[i & mask], comp);
+    }
+    return elapsedSeconds(start) / operations * 1e9;
+}
+
+// Compara as aridades 2, 4 e 8 com heaps do tamanho da L1 até a DRAM
+void benchmarkArity(bool isMinHeap) {
+    const int sizes[] = {1 << 12, 1 << 15, 1 << 18, 1 << 21, 1 << 24};
+    const int arities[] = {2, 4, 8};
+    const int operations = 2000000;
+    mt19937 rng(42);
+
+    vector<int> updates(1 << 20);
+    for (int& v : updates) v = rng();
+
+    for (int n : sizes) {
+        vector<int> values(n);
+        for (int& v : values) v = rng();
+
+        cout << "n = " << n << " (" << n * sizeof(int) / 1024 << " KB)";
+        for (int arity : arities) {
+            double ns = 0;
+            dispatchHeap(isMinHeap, arity, [&](auto a, auto comp) {
+                ns = measureHold<decltype(a)::value>(values, updates, operations, comp);
+            });
+            cout << " | d = " << arity << ": " << ns << " ns";
+        }
+        cout << endl;
+    }
+}
+
+// Grafo aleatório em formato CSR (listas de adjacência contíguas)
+struct Graph {
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+};
+
+Graph generateGraph(int vertices, int degree, mt19937& rng) {
+    Graph g;
+    g.offsets.resize(vertices + 1);
+    for (int v = 0; v < vertices; v++) {
+        g.offsets[v] = v * (degree + 1);
+
+        // Aresta para o próximo vértice garante que todos são alcançáveis
+        g.targets.push_back((v + 1) % vertices);
+        g.weights.push_back(1 + rng() % 100);
+
+        for (int e = 0; e < degree; e++) {
+            g.targets.push_back(rng() % vertices);
+            g.weights.push_back(1 + rng() % 100);
+        }
+    }
+    g.offsets[vertices] = vertices * (degree + 1);
+    return g;
+}
+
+// Dijkstra com decreaseKey: no máximo um item por vértice na heap
+vector<int> dijkstraIndexed(const Graph& g, int source, size_t& peakSize) {
+    int vertices = g.offsets.size() - 1;
+    vector<int> dist(vertices, INT_MAX), handleOf(vertices, -1), vertexOf;
+    IndexedHeap h;
+    less<int> comp;
+
+    dist[source] = 0;
+    handleOf[source] = insert(h, 0, comp);
+    vertexOf.resize(h.position.size());
+    vertexOf[handleOf[source]] = source;
+    peakSize = 1;
+
+    while (!h.entries.empty()) {
+        int v = vertexOf[removeExtreme(h, comp)];
+        handleOf[v] = -1;
+
+        for (int e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+            int u = g.targets[e];
+            int candidate = dist[v] + g.weights[e];
+            if (candidate >= dist[u]) continue;
+
+            dist[u] = candidate;
+            if (handleOf[u] != -1) {
+                decreaseKey(h, handleOf[u], candidate, comp);
+            } else {
+                handleOf[u] = insert(h, candidate, comp);
+                if ((int)vertexOf.size() <= handleOf[u]) vertexOf.resize(handleOf[u] + 1);
+                vertexOf[handleOf[u]] = u;
+            }
+        }
+        peakSize = max(peakSize, h.entries.size());
+    }
+    return dist;
+}
+
+// Dijkstra "preguiçoso": insere duplicatas e descarta remoções obsoletas
+vector<int> dijkstraLazy(const Graph& g, int source, size_t& peakSize) {
+    int vertices = g.offsets.size() - 1;
+    vector<int> dist(vertices, INT_MAX), vertexOf;
+    IndexedHeap h;
+    less<int> comp;
+
+    auto push = [&](int key, int vertex) {
+        int handle = insert(h, key, comp);
+        if ((int)vertexOf.size() <= handle) vertexOf.resize(handle + 1);
+        vertexOf[handle] = vertex;
+    };
+
+    dist[source] = 0;
+    push(0, source);
+    peakSize = 1;
+
+    while (!h.entries.empty()) {
+        int key = h.entries[0].key;
+        int v = vertexOf[removeExtreme(h, comp)];
+        if (key > dist[v]) continue;
+
+        for (int e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+            int u = g.targets[e];
+            int candidate = dist[v] + g.weights[e];
+            if (candidate < dist[u]) {
+                dist[u] = candidate;
+                push(candidate, u);
+            }
+        }
+        peakSize = max(peakSize, h.entries.size());
+    }
+    return dist;
+}
+
+// Compara Dijkstra com decreaseKey e com inserções duplicadas
+void benchmarkDijkstra() {
+    const int sizes[] = {100000, 1000000, 4000000};
+    const int degree = 8;
+    mt19937 rng(42);
+
+    for (int n : sizes) {
+        Graph g = generateGraph(n, degree, rng);
+        size_t indexedPeak, lazyPeak;
+
+        auto start = chrono::steady_clock::now();
+        vector<int> indexedDist = dijkstraIndexed(g, 0, indexedPeak);
+        double indexedTime = elapsedSeconds(start);
+
+        start = chrono::steady_clock::now();
+        vector<int> lazyDist = dijkstraLazy(g, 0, lazyPeak);
+        double lazyTime = elapsedSeconds(start);
+
+        cout << "V = " << n << ", E = " << g.targets.size()
+             << " | decreaseKey: " << indexedTime * 1e3 << " ms, pico " << indexedPeak
+             << " | duplicatas: " << lazyTime * 1e3 << " ms, pico " << lazyPeak
+             << (indexedDist == lazyDist ? "" : " | ERRO: distâncias diferentes") << endl;
+    }
+}
+
+// Heap comum protegida por uma única trava, usada como referência
+struct LockedHeap {
+    mutex lock;
+    HeapStorage heap;
+};
+
+template <typename Compare>
+void insert(LockedHeap& lh, int value, Compare comp, mt19937&) {
+    lock_guard<mutex> guard(lh.lock);
+    insert(lh.heap, value, comp);
+}
+
+template <typename Compare>
+bool removeExtreme(LockedHeap& lh, int& value, Compare comp, mt19937&) {
+    lock_guard<mutex> guard(lh.lock);
+    if (lh.heap.empty()) return false;
+    value = lh.heap[0];
+    removeExtreme(lh.heap, comp);
+    return true;
+}
+
+// Cada thread alterna inserções e remoções; retorna operações por segundo
+template <typename Queue, typename Compare>
+double measureConcurrentThroughput(Queue& queue, int threads, int operationsPerThread, Compare comp) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&queue, operationsPerThread, comp, t]() {
+            mt19937 rng(1000 + t);
+            int value;
+            for (int i = 0; i < operationsPerThread; i++) {
+                if (i & 1) removeExtreme(queue, value, comp, rng);
+                else insert(queue, (int)rng(), comp, rng);
+            }
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    return (double)threads * operationsPerThread / elapsedSeconds(start);
+}
+
+// Árvore de Fenwick sobre os valores restantes, para calcular o posto
+// (quantos valores melhores ainda estavam na fila) de cada remoção
+struct FenwickTree {
+    vector<int> tree;
+
+    FenwickTree(int n) : tree(n + 1, 0) {}
+
+    void add(int index, int delta) {
+        for (index++; index < (int)tree.size(); index += index & -index) tree[index] += delta;
+    }
+
+    int prefixSum(int index) const {
+        int sum = 0;
+        for (; index > 0; index -= index & -index) sum += tree[index];
+        return sum;
+    }
+};
+
+// Remove todos os valores 0..n-1 com várias threads e mede o erro de posto
+// das remoções, na ordem global em que foram concluídas
+template <typename Compare>
+void measureRankError(int threads, int n, Compare comp, bool isMinHeap, double& meanError, int& maxError) {
+    MultiQueue mq(2 * threads);
+    mt19937 rng(7);
+    for (int v = 0; v < n; v++) insert(mq, v, comp, rng);
+
+    vector<int> order(n);
+    atomic<int> ticket{0};
+    vector<thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            mt19937 localRng(2000 + t);
+            int value;
+            while (removeExtreme(mq, value, comp, localRng)) {
+                order[ticket.fetch_add(1)] = value;
+            }
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    FenwickTree remaining(n);
+    for (int v = 0; v < n; v++) remaining.add(v, 1);
+
+    long long total = 0;
+    maxError = 0;
+    for (int i = 0; i < n; i++) {
+        int v = order[i];
+        int better = isMinHeap ? remaining.prefixSum(v) : remaining.prefixSum(n) - remaining.prefixSum(v + 1);
+        total += better;
+        maxError = max(maxError, better);
+        remaining.add(v, -1);
+    }
+    meanError = (double)total / n;
+}
+
+// Vazão da MultiQueue e da heap com trava global para 1..2*núcleos threads
+void benchmarkConcurrent(bool isMinHeap) {
+    const int prefill = 1000000;
+    const int operationsPerThread = 2000000;
+    int maxThreads = max(2u, 2 * thread::hardware_concurrency());
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double multiOps = 0, lockedOps = 0, meanError = 0;
+        int maxError = 0;
+
+        dispatchHeap(isMinHeap, 2, [&](auto, auto comp) {
+            mt19937 rng(42);
+
+            MultiQueue mq(2 * threads);
+            LockedHeap lh;
+            for (int i = 0; i < prefill; i++) {
+                int value = rng();
+                insert(mq, value, comp, rng);
+                insert(lh, value, comp, rng);
+            }
+
+            multiOps = measureConcurrentThroughput(mq, threads, operationsPerThread, comp);
+            lockedOps = measureConcurrentThroughput(lh, threads, operationsPerThread, comp);
+            measureRankError(threads, prefill, comp, isMinHeap, meanError, maxError);
+        });
+
+        cout << "threads = " << threads
+             << " | MultiQueue: " << multiOps / 1e6 << " M ops/s"
+             << " | trava global: " << lockedOps / 1e6 << " M ops/s"
+             << " | erro de posto médio " << meanError << ", máximo " << maxError << endl;
+    }
+}
+
+// Gerador xorshift: rápido o bastante para não dominar o fluxo de 10^8 valores
+struct XorShift32 {
+    unsigned state;
+
+    unsigned next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+// Lê os valores do arquivo (se houver) ou do gerador, chamando consume(v)
+template <typename Consumer>
+long long streamValues(const string& filename, long long count, Consumer consume) {
+    long long read = 0;
+    if (filename != "-") {
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Erro ao abrir o arquivo!\n";
+            return 0;
+        }
+        int v;
+        while (file >> v) {
+            consume(v);
+            read++;
+        }
+        return read;
+    }
+
+    XorShift32 rng{2463534242u};
+    for (; read < count; read++) {
+        consume((int)rng.next());
+    }
+    return read;
+}
+
+// Top-k sobre um fluxo de valores e operações em lote
+void benchmarkStreaming(bool isMinHeap) {
+    const long long count = 100000000;
+    const int ks[] = {100, 10000};
+    string filename;
+
+    cout << "Arquivo com os valores (ou - para gerar 10^8): ";
+    cin >> filename;
+
+    // A heap do top-k tem a ordem inversa: numa Max-Heap queremos os k maiores,
+    // então a raiz deve ser o menor deles
+    dispatchHeap(!isMinHeap, 2, [&](auto, auto comp) {
+        for (int k : ks) {
+            HeapStorage bounded, naive;
+            bounded.reserve(k);
+            naive.reserve(k + 1);
+
+            auto start = chrono::steady_clock::now();
+            long long n = streamValues(filename, count, [&](int v) { pushTopK(bounded, v, k, comp); });
+            double boundedTime = elapsedSeconds(start);
+
+            start = chrono::steady_clock::now();
+            streamValues(filename, count, [&](int v) {
+                insert(naive, v, comp);
+                if ((int)naive.size() > k) removeExtreme(naive, comp);
+            });
+            double naiveTime = elapsedSeconds(start);
+
+            sort(bounded.begin(), bounded.end());
+            sort(naive.begin(), naive.end());
+
+            cout << "k = " << k << ", " << n << " valores"
+                 << " | top-k na raiz: " << n / boundedTime / 1e6 << " M/s"
+                 << " | inserir + remover: " << n / naiveTime / 1e6 << " M/s"
+                 << (bounded == naive ? "" : " | ERRO: resultados diferentes") << endl;
+        }
+    });
+
+    // Lotes de 10^5 valores numa heap de 10^7 elementos
+    const int n = 10000000, batch = 100000;
+    mt19937 rng(42);
+    vector<int> values(n), extra(batch);
+    for (int& v : values) v = rng();
+    for (int& v : extra) v = rng();
+
+    HeapStorage heap;
+    buildHeap(heap, values, isMinHeap);
+    HeapStorage copy = heap;
+
+    auto start = chrono::steady_clock::now();
+    pushBatch(heap, extra, isMinHeap);
+    double batchTime = elapsedSeconds(start);
+
+    start = chrono::steady_clock::now();
+    for (int v : extra) insert(copy, v, isMinHeap);
+    double singleTime = elapsedSeconds(start);
+
+    cout << "pushBatch(" << batch << ") em " << n << ": " << batchTime * 1e3 << " ms"
+         << " | inserções: " << singleTime * 1e3 << " ms" << endl;
+
+    const int pops[] = {1000, 1000000, 5000000};
+    for (int k : pops) {
+        HeapStorage batchHeap = heap, singleHeap = heap;
+        vector<int> batchOut, singleOut;
+
+        start = chrono::steady_clock::now();
+        popBatch(batchHeap, k, batchOut, isMinHeap);
+        batchTime = elapsedSeconds(start);
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < k; i++) {
+            singleOut.push_back(singleHeap[0]);
+            removeExtreme(singleHeap, isMinHeap);
+        }
+        singleTime = elapsedSeconds(start);
+
+        cout << "popBatch(" << k << "): " << batchTime * 1e3 << " ms"
+             << " | remoções: " << singleTime * 1e3 << " ms"
+             << (batchOut == singleOut ? "" : " | ERRO: resultados diferentes") << endl;
+    }
+}
+
+// Submenu com os benchmarks da heap
+void runBenchmarks(bool isMinHeap) {
+    int choice;
+    cout << "\n1. Remoção do extremo (10^6 a 10^7)\n2. Heapify-down: bool x template\n3. Construção em lote x inserções\n4. Aridade 2/4/8 (L1 até DRAM)\n5. Dijkstra: decreaseKey x duplicatas\n6. Concorrente: MultiQueue x trava global\n7. Top-k em fluxo e operações em lote\nEscolha um benchmark: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            benchmarkRemoveExtreme(isMinHeap);
+            break;
+        case 2:
+            benchmarkComparator(isMinHeap);
+            break;
+        case 3:
+            benchmarkBuildHeap(isMinHeap);
+            break;
+        case 4:
+            benchmarkArity(isMinHeap);
+            break;
+        case 5:
+            benchmarkDijkstra();
+            break;
+        case 6:
+            benchmarkConcurrent(isMinHeap);
+            break;
+        case 7:
+            benchmarkStreaming(isMinHeap);
+            break;
+        default:
+            cout << "Opção inválida.\n";
+    }
 }
 
 int main() {
-    Node* root = nullptr;
-    queue<Node*> nodes;
-    int choice, key;
+    HeapStorage heap;
+    int choice, arity;
     bool isMinHeap;
 
     cout << "Escolha o tipo de heap: (1 para Min-Heap, 0 para Max-Heap): ";
     cin >> isMinHeap;
 
+    cout << "Escolha a aridade da heap (2, 4 ou 8): ";
+    cin >> arity;
+    if (arity != 2 && arity != 4 && arity != 8) {
+        cout << "Aridade inválida, usando heap binária.\n";
+        arity = 2;
+    }
+
     while (true) {
-        cout << "\n1. Inserir\n2. Remover Extremo\n3. Percurso Nível\n4. Gerar Grafo\n5. Heapify\n6. Sair\nEscolha uma opção: ";
+        cout << "\n1. Inserir\n2. Remover Extremo\n3. Percurso Nível\n4. Gerar Grafo\n5. Heapify\n6. Benchmarks\n7. Sair\nEscolha uma opção: ";
         cin >> choice;
 
         switch (choice) {
@@ -209,29 +1208,44 @@ int main() {
                 int qtd;
                 cout << "Digite a quantidade de valores a serem inseridos: ";
                 cin >> qtd;
+                if (qtd < 0) {
+                    cout << "Quantidade inválida.\n";
+                    break;
+                }
 
                 cout << "Digite os valores para inserir: ";
-                for (int i = 0; i < qtd; i++) {
-                    int v;
-                    cin >> v;
-                    root = insert(root, v, nodes, isMinHeap);
+                {
+                    vector<int> values(qtd);
+                    for (int i = 0; i < qtd; i++) {
+                        cin >> values[i];
+                    }
+
+                    // Heap vazia: constrói tudo de uma vez
+                    if (heap.empty()) {
+                        buildHeap(heap, values, isMinHeap, arity);
+                    } else {
+                        pushBatch(heap, values, isMinHeap, arity);
+                    }
                 }
                 break;
             case 2:
-                root = removeExtreme(root, isMinHeap);
+                removeExtreme(heap, isMinHeap, arity);
                 break;
             case 3:
                 cout << "Percurso Nível: ";
-                levelOrder(root);
+                levelOrder(heap);
                 break;
             case 4:
-                saveGraphToFile(root, "heap.dot");
+                saveGraphToFile(heap, "heap.dot", arity);
                 break;
             case 5:
-                heapify(root, isMinHeap);
+                heapify(heap, isMinHeap, arity);
                 cout << "Heap reestruturada com sucesso!\n";
                 break;
             case 6:
+                runBenchmarks(isMinHeap);
+                break;
+            case 7:
                 cout << "Saindo...\n";
                 return 0;
             default:
@@ -0,0 +1,434 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Percursos iterativos das árvores binárias (AVL, ABB e árvore binária).
+// Os percursos usam uma pilha explícita no heap, então árvores degeneradas
+// não estouram a pilha de chamadas, e não fazem E/S: cada nó é entregue a
+// visit(node), que decide o que fazer com ele. O percurso em ordem também
+// está disponível como iterador, para uso em for de intervalo, e há um
+// iterador bidirecional que começa em qualquer posição (lower/upper bound)
+// para varrer intervalos de chaves.
+//
+// Handle identifica um nó: um ponteiro, ou um índice num pool de nós.
+// Um handle falso (nullptr ou 0) é a subárvore vazia; left(h) e right(h)
+// devolvem os filhos. Para structs com ponteiros left e right há versões
+// que dispensam os acessores.
+
+template <typename Node>
+struct LeftChild {
+    Node* operator()(Node* node) const { return node->left; }
+};
+
+template <typename Node>
+struct RightChild {
+    Node* operator()(Node* node) const { return node->right; }
+};
+
+// Pré-ordem: raiz, esquerda, direita. Desce pela esquerda sem passar pela
+// pilha; só os filhos direitos ficam pendentes
+template <typename Handle, typename Left, typename Right, typename Visit>
+void preorderVisit(Handle root, Left left, Right right, Visit visit) {
+    std::vector<Handle> stack;
+    stack.reserve(64);
+    Handle node = root;
+    while (true) {
+        while (node) {
+            Handle next = left(node);
+            if (right(node)) stack.push_back(right(node));
+            visit(node);
+            node = next;
+        }
+        if (stack.empty()) break;
+        node = stack.back();
+        stack.pop_back();
+    }
+}
+
+// Em ordem: esquerda, raiz, direita
+template <typename Handle, typename Left, typename Right, typename Visit>
+void inorderVisit(Handle root, Left left, Right right, Visit visit) {
+    std::vector<Handle> stack;
+    stack.reserve(64);
+    Handle node = root;
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = left(node);
+        }
+        node = stack.back();
+        stack.pop_back();
+        Handle next = right(node);
+        visit(node);
+        node = next;
+    }
+}
+
+// Pós-ordem: esquerda, direita, raiz. O nó não é lido depois de visitado,
+// então visit pode liberá-lo (é assim que as árvores são destruídas)
+template <typename Handle, typename Left, typename Right, typename Visit>
+void postorderVisit(Handle root, Left left, Right right, Visit visit) {
+    std::vector<Handle> stack;
+    stack.reserve(64);
+    Handle node = root;
+    Handle last = Handle();
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = left(node);
+        }
+        Handle top = stack.back();
+        if (right(top) && right(top) != last) {
+            node = right(top);
+        } else {
+            stack.pop_back();
+            visit(top);
+            last = top;
+        }
+    }
+}
+
+// Por nível, da raiz para as folhas. A fila é um vetor com índice de
+// leitura, sem alocação por nó
+template <typename Handle, typename Left, typename Right, typename Visit>
+void levelOrderVisit(Handle root, Left left, Right right, Visit visit) {
+    if (!root) return;
+    std::vector<Handle> queue(1, root);
+    for (size_t head = 0; head < queue.size(); head++) {
+        Handle node = queue[head];
+        visit(node);
+        if (left(node)) queue.push_back(left(node));
+        if (right(node)) queue.push_back(right(node));
+    }
+}
+
+template <typename Node, typename Visit>
+void preorderVisit(Node* root, Visit visit) {
+    preorderVisit(root, LeftChild<Node>(), RightChild<Node>(), visit);
+}
+
+template <typename Node, typename Visit>
+void inorderVisit(Node* root, Visit visit) {
+    inorderVisit(root, LeftChild<Node>(), RightChild<Node>(), visit);
+}
+
+template <typename Node, typename Visit>
+void postorderVisit(Node* root, Visit visit) {
+    postorderVisit(root, LeftChild<Node>(), RightChild<Node>(), visit);
+}
+
+template <typename Node, typename Visit>
+void levelOrderVisit(Node* root, Visit visit) {
+    levelOrderVisit(root, LeftChild<Node>(), RightChild<Node>(), visit);
+}
+
+// Iterador em ordem que devolve handles; a pilha guarda o caminho até o
+// nó atual
+template <typename Handle, typename Left, typename Right>
+class InorderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Handle;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Handle*;
+    using reference = const Handle&;
+
+    InorderIterator(Left leftChild, Right rightChild) : left(leftChild), right(rightChild) {}
+    InorderIterator(Handle root, Left leftChild, Right rightChild) : left(leftChild), right(rightChild) {
+        stack.reserve(64);
+        pushLeft(root);
+    }
+
+    const Handle& operator*() const { return stack.back(); }
+
+    InorderIterator& operator++() {
+        Handle node = stack.back();
+        stack.pop_back();
+        pushLeft(right(node));
+        return *this;
+    }
+
+    bool operator==(const InorderIterator& other) const {
+        if (stack.empty() || other.stack.empty()) return stack.empty() == other.stack.empty();
+        return stack.back() == other.stack.back();
+    }
+    bool operator!=(const InorderIterator& other) const { return !(*this == other); }
+
+private:
+    Left left;
+    Right right;
+    std::vector<Handle> stack;
+
+    void pushLeft(Handle node) {
+        for (; node; node = left(node)) stack.push_back(node);
+    }
+};
+
+template <typename Handle, typename Left, typename Right>
+struct InorderRange {
+    Handle root;
+    Left left;
+    Right right;
+
+    InorderIterator<Handle, Left, Right> begin() const { return InorderIterator<Handle, Left, Right>(root, left, right); }
+    InorderIterator<Handle, Left, Right> end() const { return InorderIterator<Handle, Left, Right>(left, right); }
+};
+
+// for (auto node : inorderRange(root, left, right)) ...
+template <typename Handle, typename Left, typename Right>
+InorderRange<Handle, Left, Right> inorderRange(Handle root, Left left, Right right) {
+    return InorderRange<Handle, Left, Right>{root, left, right};
+}
+
+// for (Node* node : inorderRange(root)) ...
+template <typename Node>
+InorderRange<Node*, LeftChild<Node>, RightChild<Node>> inorderRange(Node* root) {
+    return inorderRange(root, LeftChild<Node>(), RightChild<Node>());
+}
+
+// Iterador em ordem que guarda o caminho inteiro da raiz até o nó atual,
+// então anda nos dois sentidos: ++ vai para o sucessor e -- para o
+// antecessor, em O(1) amortizado, sem recursão. Com Forward = false os
+// papéis se invertem (ordem decrescente). Caminho vazio é o fim; o
+// iterador guarda a raiz para que --fim volte ao último nó do sentido
+template <typename Handle, typename Left, typename Right, bool Forward = true>
+class PathIterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Handle;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Handle;  // por valor: std::reverse_iterator lê de uma cópia temporária
+
+    PathIterator(Handle treeRoot, Left leftChild, Right rightChild)
+        : root(treeRoot), left(leftChild), right(rightChild) {}
+    PathIterator(Handle treeRoot, std::vector<Handle> nodes, Left leftChild, Right rightChild)
+        : root(treeRoot), left(leftChild), right(rightChild), path(std::move(nodes)) {}
+
+    Handle operator*() const { return path.back(); }
+
+    PathIterator& operator++() {
+        if (Forward) successor();
+        else predecessor();
+        return *this;
+    }
+
+    PathIterator& operator--() {
+        if (Forward) predecessor();
+        else successor();
+        return *this;
+    }
+
+    bool operator==(const PathIterator& other) const {
+        if (path.empty() || other.path.empty()) return path.empty() == other.path.empty();
+        return path.back() == other.path.back();
+    }
+    bool operator!=(const PathIterator& other) const { return !(*this == other); }
+
+private:
+    Handle root;
+    Left left;
+    Right right;
+    std::vector<Handle> path;
+
+    // Menor nó da subárvore direita; sem ela, o primeiro ancestral de quem
+    // o nó está à esquerda. A partir do fim, o menor nó da árvore (só
+    // acontece no sentido decrescente, em --fim)
+    void successor() {
+        if (path.empty()) {
+            for (Handle node = root; node; node = left(node)) path.push_back(node);
+            return;
+        }
+        Handle node = path.back();
+        if (right(node)) {
+            for (node = right(node); node; node = left(node)) path.push_back(node);
+            return;
+        }
+        path.pop_back();
+        while (!path.empty() && right(path.back()) == node) {
+            node = path.back();
+            path.pop_back();
+        }
+    }
+
+    // A partir do fim, o maior nó da árvore
+    void predecessor() {
+        if (path.empty()) {
+            for (Handle node = root; node; node = right(node)) path.push_back(node);
+            return;
+        }
+        Handle node = path.back();
+        if (left(node)) {
+            for (node = left(node); node; node = right(node)) path.push_back(node);
+            return;
+        }
+        path.pop_back();
+        while (!path.empty() && left(path.back()) == node) {
+            node = path.back();
+            path.pop_back();
+        }
+    }
+};
+
+// Buscas de posição numa árvore de busca. before(h) deve ser verdadeiro
+// para um prefixo da ordem (por exemplo, chave(h) < x) e falso no resto;
+// a descida é iterativa, O(altura), e devolve o caminho da raiz até o nó
+// (vazio se não houver)
+
+// Primeiro nó em que before é falso
+template <typename Handle, typename Left, typename Right, typename Before>
+std::vector<Handle> seekFirst(Handle root, Left left, Right right, Before before) {
+    std::vector<Handle> path;
+    path.reserve(64);
+    size_t found = 0;
+    for (Handle node = root; node;) {
+        path.push_back(node);
+        if (before(node)) {
+            node = right(node);
+        } else {
+            found = path.size();
+            node = left(node);
+        }
+    }
+    path.resize(found);
+    return path;
+}
+
+// Último nó em que before é verdadeiro
+template <typename Handle, typename Left, typename Right, typename Before>
+std::vector<Handle> seekLast(Handle root, Left left, Right right, Before before) {
+    std::vector<Handle> path;
+    path.reserve(64);
+    size_t found = 0;
+    for (Handle node = root; node;) {
+        path.push_back(node);
+        if (before(node)) {
+            found = path.size();
+            node = right(node);
+        } else {
+            node = left(node);
+        }
+    }
+    path.resize(found);
+    return path;
+}
+
+// Par de iteradores [first, last) para uso em for de intervalo
+template <typename Iterator>
+struct IteratorRange {
+    Iterator first;
+    Iterator last;
+
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+};
+
+// Versões recursivas, mantidas só como referência para os benchmarks
+template <typename Handle, typename Left, typename Right, typename Visit>
+void preorderRecursive(Handle node, Left& left, Right& right, Visit& visit) {
+    if (!node) return;
+    visit(node);
+    preorderRecursive(left(node), left, right, visit);
+    preorderRecursive(right(node), left, right, visit);
+}
+
+template <typename Handle, typename Left, typename Right, typename Visit>
+void inorderRecursive(Handle node, Left& left, Right& right, Visit& visit) {
+    if (!node) return;
+    inorderRecursive(left(node), left, right, visit);
+    visit(node);
+    inorderRecursive(right(node), left, right, visit);
+}
+
+template <typename Handle, typename Left, typename Right, typename Visit>
+void postorderRecursive(Handle node, Left& left, Right& right, Visit& visit) {
+    if (!node) return;
+    postorderRecursive(left(node), left, right, visit);
+    postorderRecursive(right(node), left, right, visit);
+    visit(node);
+}
+
+// Tempo médio por nó (ns) de um percurso; a soma dos valores impede que o
+// compilador descarte o laço
+template <typename Handle, typename Value, typename Traversal>
+double traversalNanosPerNode(Handle root, Value& value, long nodes, int rounds, Traversal traversal,
+                             long long& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        long long sum = 0;
+        auto visit = [&sum, &value](Handle node) { sum += value(node); };
+        traversal(root, visit);
+        checksum += sum;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds / rounds / nodes * 1e9;
+}
+
+// Compara os percursos iterativos com os recursivos numa árvore pronta;
+// value(h) é a chave do nó. Em árvores muito profundas a versão recursiva
+// estouraria a pilha de chamadas, então ela só roda quando recursiveSafe
+// é verdadeiro
+template <typename Handle, typename Left, typename Right, typename Value>
+void reportTraversalTimes(const char* name, Handle root, Left left, Right right, Value value, long nodes,
+                          bool recursiveSafe) {
+    int rounds = (int)std::max(1L, 10000000L / nodes);
+    long long iterativeSum = 0, recursiveSum = 0, iteratorSum = 0;
+
+    auto pre = [&](Handle r, auto& v) { preorderVisit(r, left, right, v); };
+    auto in = [&](Handle r, auto& v) { inorderVisit(r, left, right, v); };
+    auto post = [&](Handle r, auto& v) { postorderVisit(r, left, right, v); };
+    auto level = [&](Handle r, auto& v) { levelOrderVisit(r, left, right, v); };
+    auto iterator = [&](Handle r, auto& v) {
+        for (Handle node : inorderRange(r, left, right)) v(node);
+    };
+    auto preRec = [&](Handle r, auto& v) { preorderRecursive(r, left, right, v); };
+    auto inRec = [&](Handle r, auto& v) { inorderRecursive(r, left, right, v); };
+    auto postRec = [&](Handle r, auto& v) { postorderRecursive(r, left, right, v); };
+
+    double iterative[3] = {
+        traversalNanosPerNode(root, value, nodes, rounds, pre, iterativeSum),
+        traversalNanosPerNode(root, value, nodes, rounds, in, iterativeSum),
+        traversalNanosPerNode(root, value, nodes, rounds, post, iterativeSum),
+    };
+    double levelNs = traversalNanosPerNode(root, value, nodes, rounds, level, iterativeSum);
+    double iteratorNs = traversalNanosPerNode(root, value, nodes, rounds, iterator, iteratorSum);
+
+    std::cout << name << ", n = " << nodes << "\n";
+    const char* orders[3] = {"pré-ordem", "em ordem", "pós-ordem"};
+    if (recursiveSafe) {
+        double recursive[3] = {
+            traversalNanosPerNode(root, value, nodes, rounds, preRec, recursiveSum),
+            traversalNanosPerNode(root, value, nodes, rounds, inRec, recursiveSum),
+            traversalNanosPerNode(root, value, nodes, rounds, postRec, recursiveSum),
+        };
+        for (int i = 0; i < 3; i++) {
+            std::cout << "  " << orders[i] << ": iterativo " << iterative[i] << " ns/nó"
+                      << " | recursivo " << recursive[i] << " ns/nó\n";
+        }
+    } else {
+        for (int i = 0; i < 3; i++) {
+            std::cout << "  " << orders[i] << ": iterativo " << iterative[i] << " ns/nó"
+                      << " | recursivo: não executado (estouraria a pilha)\n";
+        }
+    }
+    std::cout << "  nível: " << levelNs << " ns/nó | iterador em ordem: " << iteratorNs << " ns/nó";
+    if (iterativeSum != 4 * iteratorSum || (recursiveSafe && recursiveSum != 3 * iteratorSum)) {
+        std::cout << " | ERRO: somas diferentes";
+    }
+    std::cout << std::endl;
+}
+
+template <typename Node>
+void reportTraversalTimes(const char* name, Node* root, long nodes, bool recursiveSafe) {
+    auto value = [](Node* node) { return node->value; };
+    reportTraversalTimes(name, root, LeftChild<Node>(), RightChild<Node>(), value, nodes, recursiveSafe);
+}
+
+#endif
@@ -1,129 +1,2926 @@
 #include <iostream>
-#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <malloc.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <new>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include <string>
 #include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include "graphviz.h"
 using namespace std;
 
-// Estrutura de nó para a Trie
+// Número de filhos guardados diretamente no nó antes de trocar para a
+// tabela de 256 entradas
+const int TRIE_INLINE_CHILDREN = 4;
+
+// Estrutura de nó para a Trie. Nós com poucos filhos (a grande maioria)
+// guardam as chaves ordenadas e os ponteiros no próprio nó; nós com muitos
+// filhos usam uma tabela direta indexada pelo byte. Cada nó também guarda
+// o peso da sua palavra e o maior peso da subárvore, usado pelo
+// autocompletar para visitar primeiro os ramos mais pesados.
 struct TrieNode {
-    unordered_map<char, TrieNode*> children;
+    unsigned char keys[TRIE_INLINE_CHILDREN];
+    uint16_t childCount;
+    bool isEndOfWord;
+    uint32_t weight;
+    uint32_t maxWeight;
+    union {
+        TrieNode* children[TRIE_INLINE_CHILDREN];  // childCount <= TRIE_INLINE_CHILDREN
+        TrieNode** table;                          // childCount > TRIE_INLINE_CHILDREN
+    };
+
+    TrieNode() : childCount(0), isEndOfWord(false), weight(0), maxWeight(0) {}
+};
+
+// Arena para os nós da Trie: os nós e as tabelas de 256 entradas são
+// recortados de blocos grandes, os liberados por remove vão para listas
+// livres e a Trie inteira é descartada de uma vez liberando os blocos.
+// Sem arena (nullptr) os nós usam new/delete.
+const size_t TRIE_ARENA_BLOCK_BYTES = 1 << 20;
+
+struct TrieArena {
+    vector<char*> blocks;
+    size_t blockUsed;
+    TrieNode* freeNodes;    // encadeados pelo primeiro ponteiro de cada nó
+    TrieNode** freeTables;  // encadeadas pela primeira entrada de cada tabela
+
+    TrieArena() : blockUsed(TRIE_ARENA_BLOCK_BYTES), freeNodes(nullptr), freeTables(nullptr) {}
+
+    // Liberação de todos os nós em O(número de blocos)
+    ~TrieArena() {
+        for (char* block : blocks) delete[] block;
+    }
+};
+
+// Recorta bytes do bloco atual (abre um novo bloco se não couber)
+void* arenaAllocate(TrieArena* arena, size_t bytes) {
+    bytes = (bytes + alignof(void*) - 1) & ~(alignof(void*) - 1);
+    if (arena->blockUsed + bytes > TRIE_ARENA_BLOCK_BYTES) {
+        arena->blocks.push_back(new char[TRIE_ARENA_BLOCK_BYTES]);
+        arena->blockUsed = 0;
+    }
+
+    void* memory = arena->blocks.back() + arena->blockUsed;
+    arena->blockUsed += bytes;
+    return memory;
+}
+
+// Passa os blocos de outra arena para esta e apaga a outra; os nós de from
+// continuam válidos. As listas livres de from são descartadas.
+void mergeArena(TrieArena* into, TrieArena* from) {
+    // O bloco em uso continua sendo o último
+    auto position = into->blocks.empty() ? into->blocks.end() : into->blocks.end() - 1;
+    into->blocks.insert(position, from->blocks.begin(), from->blocks.end());
+    from->blocks.clear();
+    delete from;
+}
+
+TrieNode* createNode(TrieArena* arena) {
+    if (!arena) return new TrieNode();
+
+    void* memory;
+    if (arena->freeNodes) {
+        memory = arena->freeNodes;
+        arena->freeNodes = *reinterpret_cast<TrieNode**>(memory);
+    } else {
+        memory = arenaAllocate(arena, sizeof(TrieNode));
+    }
+    return new (memory) TrieNode();
+}
+
+void releaseNode(TrieNode* node, TrieArena* arena) {
+    if (!arena) {
+        delete node;
+        return;
+    }
+
+    *reinterpret_cast<TrieNode**>(node) = arena->freeNodes;
+    arena->freeNodes = node;
+}
+
+TrieNode** createTable(TrieArena* arena) {
+    if (!arena) return new TrieNode*[256]();
+
+    TrieNode** table;
+    if (arena->freeTables) {
+        table = arena->freeTables;
+        arena->freeTables = reinterpret_cast<TrieNode**>(table[0]);
+    } else {
+        table = static_cast<TrieNode**>(arenaAllocate(arena, 256 * sizeof(TrieNode*)));
+    }
+    fill(table, table + 256, nullptr);
+    return table;
+}
+
+void releaseTable(TrieNode** table, TrieArena* arena) {
+    if (!arena) {
+        delete[] table;
+        return;
+    }
+
+    table[0] = reinterpret_cast<TrieNode*>(arena->freeTables);
+    arena->freeTables = table;
+}
+
+// Buscar o filho correspondente ao caractere (nullptr se não existir)
+TrieNode* findChild(const TrieNode* node, unsigned char ch) {
+    if (node->childCount > TRIE_INLINE_CHILDREN) {
+        return node->table[ch];
+    }
+
+    for (int i = 0; i < node->childCount; i++) {
+        if (node->keys[i] == ch) return node->children[i];
+        if (node->keys[i] > ch) break;
+    }
+    return nullptr;
+}
+
+// Adicionar um filho novo, mantendo as chaves ordenadas
+void addChild(TrieNode* node, unsigned char ch, TrieNode* child, TrieArena* arena = nullptr) {
+    int count = node->childCount;
+
+    if (count > TRIE_INLINE_CHILDREN) {
+        node->table[ch] = child;
+    } else if (count == TRIE_INLINE_CHILDREN) {
+        // Nó cheio: passa a usar a tabela direta
+        TrieNode** table = createTable(arena);
+        for (int i = 0; i < count; i++) {
+            table[node->keys[i]] = node->children[i];
+        }
+        table[ch] = child;
+        node->table = table;
+    } else {
+        int i = count;
+        while (i > 0 && node->keys[i - 1] > ch) {
+            node->keys[i] = node->keys[i - 1];
+            node->children[i] = node->children[i - 1];
+            i--;
+        }
+        node->keys[i] = ch;
+        node->children[i] = child;
+    }
+
+    node->childCount++;
+}
+
+// Desligar um filho do nó (sem liberá-lo)
+void removeChild(TrieNode* node, unsigned char ch, TrieArena* arena = nullptr) {
+    int count = node->childCount;
+
+    if (count > TRIE_INLINE_CHILDREN) {
+        TrieNode** table = node->table;
+        table[ch] = nullptr;
+
+        // Voltou a caber no nó: troca a tabela pelo armazenamento compacto
+        if (count - 1 == TRIE_INLINE_CHILDREN) {
+            int i = 0;
+            for (int c = 0; c < 256; c++) {
+                if (table[c]) {
+                    node->keys[i] = c;
+                    node->children[i] = table[c];
+                    i++;
+                }
+            }
+            releaseTable(table, arena);
+        }
+    } else {
+        int i = 0;
+        while (i < count && node->keys[i] != ch) i++;
+        if (i == count) return;
+
+        for (; i + 1 < count; i++) {
+            node->keys[i] = node->keys[i + 1];
+            node->children[i] = node->children[i + 1];
+        }
+    }
+
+    node->childCount--;
+}
+
+// Percorre os filhos em ordem crescente de caractere
+template <typename Visitor>
+void forEachChild(TrieNode* node, Visitor visit) {
+    if (node->childCount > TRIE_INLINE_CHILDREN) {
+        for (int c = 0; c < 256; c++) {
+            if (node->table[c]) visit((unsigned char)c, node->table[c]);
+        }
+    } else {
+        for (int i = 0; i < node->childCount; i++) {
+            visit(node->keys[i], node->children[i]);
+        }
+    }
+}
+
+// As chaves são sequências de bytes: os filhos são indexados pelo byte sem
+// sinal (256 possibilidades) e uma palavra UTF-8 ocupa um nível por byte,
+// sem conversão para pontos de código na inserção ou na busca. Só a
+// exibição por caractere e o Graphviz agrupam os bytes de cada ponto de
+// código.
+
+// Tamanho da sequência UTF-8 que começa com o byte lead (1 para bytes que
+// não iniciam uma sequência, para que o percurso sempre avance)
+inline int utf8SequenceLength(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead & 0xE0) == 0xC0) return 2;
+    if ((lead & 0xF0) == 0xE0) return 3;
+    if ((lead & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+// Verificar se a palavra é UTF-8 válido (sem formas longas, surrogates ou
+// pontos de código acima de U+10FFFF)
+bool isValidUtf8(const string& word) {
+    size_t i = 0;
+    while (i < word.size()) {
+        unsigned char lead = word[i];
+        int length = utf8SequenceLength(lead);
+        if (length == 1) {
+            if (lead >= 0x80) return false;
+            i++;
+            continue;
+        }
+        if (i + length > word.size()) return false;
+
+        uint32_t codepoint = lead & (0x7F >> length);
+        for (int k = 1; k < length; k++) {
+            unsigned char next = word[i + k];
+            if ((next & 0xC0) != 0x80) return false;
+            codepoint = codepoint << 6 | (next & 0x3F);
+        }
+
+        const uint32_t minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (codepoint < minimum[length] || codepoint > 0x10FFFF ||
+            (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+            return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+// Acrescenta o ponto de código à palavra em UTF-8
+void appendUtf8(string& word, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        word.push_back(codepoint);
+    } else if (codepoint < 0x800) {
+        word.push_back(0xC0 | codepoint >> 6);
+        word.push_back(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        word.push_back(0xE0 | codepoint >> 12);
+        word.push_back(0x80 | (codepoint >> 6 & 0x3F));
+        word.push_back(0x80 | (codepoint & 0x3F));
+    } else {
+        word.push_back(0xF0 | codepoint >> 18);
+        word.push_back(0x80 | (codepoint >> 12 & 0x3F));
+        word.push_back(0x80 | (codepoint >> 6 & 0x3F));
+        word.push_back(0x80 | (codepoint & 0x3F));
+    }
+}
+
+// Percorre os filhos por ponto de código, em ordem crescente: desce pelos
+// bytes de continuação e entrega a sequência completa e o nó onde ela
+// termina. Um nó de palavra no meio de uma sequência (UTF-8 inválido) é
+// entregue com a sequência incompleta.
+template <typename Visitor>
+void forEachCodepoint(TrieNode* node, Visitor visit, string& sequence, int remaining = 0) {
+    forEachChild(node, [&](unsigned char ch, TrieNode* child) {
+        sequence.push_back(ch);
+        int left = sequence.size() == 1 ? utf8SequenceLength(ch) - 1 : remaining - 1;
+        if (left == 0 || child->isEndOfWord) visit(sequence, child);
+        else forEachCodepoint(child, visit, sequence, left);
+        sequence.pop_back();
+    });
+}
+
+template <typename Visitor>
+void forEachCodepoint(TrieNode* node, Visitor visit) {
+    string sequence;
+    forEachCodepoint(node, visit, sequence);
+}
+
+// Recalcula o maior peso da subárvore a partir do nó e dos filhos
+void refreshMaxWeight(TrieNode* node) {
+    uint32_t best = node->weight;
+    forEachChild(node, [&](unsigned char, TrieNode* child) {
+        if (child->maxWeight > best) best = child->maxWeight;
+    });
+    node->maxWeight = best;
+}
+
+// Inserir uma palavra na Trie; weight é somado ao peso da palavra (por
+// padrão cada inserção conta uma ocorrência). Com depth > 0, root é o nó
+// já alcançado pelos primeiros depth caracteres da palavra.
+void insert(TrieNode* root, const string& word, TrieArena* arena = nullptr, uint32_t weight = 1, size_t depth = 0) {
+    TrieNode* current = root;
+    for (size_t i = depth; i < word.size(); i++) {
+        unsigned char ch = word[i];
+        TrieNode* next = findChild(current, ch);
+        if (!next) {
+            next = createNode(arena);
+            addChild(current, ch, next, arena);
+        }
+        current = next;
+    }
+    current->isEndOfWord = true;
+    current->weight += weight;
+
+    // Os pesos só crescem, então basta subir o máximo ao longo do caminho
+    uint32_t total = current->weight;
+    current = root;
+    for (size_t i = depth; i < word.size(); i++) {
+        if (current->maxWeight < total) current->maxWeight = total;
+        current = findChild(current, word[i]);
+    }
+    if (current->maxWeight < total) current->maxWeight = total;
+}
+
+// Inserção em lote usando várias threads. As palavras são separadas pelo
+// primeiro byte e cada grupo é inserido, na ordem original, na subárvore
+// daquele byte; como as subárvores não compartilham nós, cada thread
+// trabalha sem travas e com arena própria, e o resultado é o mesmo da
+// inserção serial. As arenas das threads passam depois para a da Trie.
+void bulkInsert(TrieNode* root, const vector<string>& words, TrieArena* arena, int threads) {
+    vector<vector<uint32_t>> groups(256);
+    for (size_t i = 0; i < words.size(); i++) {
+        if (words[i].empty()) {
+            insert(root, words[i], arena);
+        } else {
+            groups[(unsigned char)words[i][0]].push_back(i);
+        }
+    }
+
+    // Os filhos da raiz são criados antes, e os grupos maiores saem primeiro
+    vector<int> order;
+    for (int c = 0; c < 256; c++) {
+        if (groups[c].empty()) continue;
+        if (!findChild(root, c)) addChild(root, c, createNode(arena), arena);
+        order.push_back(c);
+    }
+    sort(order.begin(), order.end(), [&](int a, int b) { return groups[a].size() > groups[b].size(); });
+
+    atomic<size_t> nextGroup{0};
+    vector<TrieArena*> arenas;
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        TrieArena* local = arena ? new TrieArena() : nullptr;
+        arenas.push_back(local);
+        workers.emplace_back([&, local]() {
+            for (size_t g = nextGroup++; g < order.size(); g = nextGroup++) {
+                TrieNode* child = findChild(root, order[g]);
+                for (uint32_t i : groups[order[g]]) insert(child, words[i], local, 1, 1);
+            }
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    for (TrieArena* local : arenas) {
+        if (local) mergeArena(arena, local);
+    }
+    refreshMaxWeight(root);
+}
+
+// Buscar uma palavra na Trie
+bool search(TrieNode* root, const string& word) {
+    TrieNode* current = root;
+    for (unsigned char ch : word) {
+        current = findChild(current, ch);
+        if (!current) {
+            return false;
+        }
+    }
+    return current->isEndOfWord;
+}
+
+// Remover uma palavra da Trie
+bool remove(TrieNode* current, const string& word, int depth = 0, TrieArena* arena = nullptr) {
+    if (!current) return false;
+
+    if (depth == word.size()) {
+        if (!current->isEndOfWord) return false;
+        current->isEndOfWord = false;
+        current->weight = 0;
+        refreshMaxWeight(current);
+        return current->childCount == 0;
+    }
+
+    unsigned char ch = word[depth];
+    TrieNode* child = findChild(current, ch);
+    if (!child) return false;
+
+    bool removeNode = remove(child, word, depth + 1, arena);
+    if (removeNode) {
+        releaseNode(child, arena);
+        removeChild(current, ch, arena);
+    }
+    refreshMaxWeight(current);
+
+    return removeNode && !current->isEndOfWord && current->childCount == 0;
+}
+
+// Liberar todos os nós da Trie alocada com new (com arena basta apagar a arena)
+void destroy(TrieNode* node) {
+    forEachChild(node, [](unsigned char, TrieNode* child) { destroy(child); });
+    if (node->childCount > TRIE_INLINE_CHILDREN) delete[] node->table;
+    delete node;
+}
+
+// Nó onde termina o prefixo (nullptr se nenhuma palavra começa com ele)
+TrieNode* findPrefix(TrieNode* root, const string& prefix) {
+    TrieNode* current = root;
+    for (unsigned char ch : prefix) {
+        current = findChild(current, ch);
+        if (!current) return nullptr;
+    }
+    return current;
+}
+
+// Verificar se alguma palavra da Trie começa com o prefixo
+bool startsWith(TrieNode* root, const string& prefix) {
+    TrieNode* node = findPrefix(root, prefix);
+    return node && (node->isEndOfWord || node->childCount > 0);
+}
+
+// Percorre sob demanda, em ordem alfabética, as palavras que começam com um
+// prefixo; cada chamada a nextCompletion custa só o trecho da árvore entre
+// uma palavra e a seguinte. A Trie não pode ser alterada durante o percurso.
+struct CompletionIterator {
+    struct Frame {
+        TrieNode* node;
+        int next;  // próximo filho (posição no nó ou byte da tabela); -1 antes da palavra do nó
+    };
+    vector<Frame> stack;
+    string word;
+};
+
+CompletionIterator completions(TrieNode* root, const string& prefix) {
+    CompletionIterator it;
+    TrieNode* node = findPrefix(root, prefix);
+    if (node) {
+        it.stack.push_back({node, -1});
+        it.word = prefix;
+    }
+    return it;
+}
+
+// Avança para a próxima palavra (e seu peso); retorna false no fim
+bool nextCompletion(CompletionIterator& it, string& word, uint32_t* weight = nullptr) {
+    while (!it.stack.empty()) {
+        CompletionIterator::Frame& frame = it.stack.back();
+        TrieNode* node = frame.node;
+
+        if (frame.next < 0) {
+            frame.next = 0;
+            if (node->isEndOfWord) {
+                word = it.word;
+                if (weight) *weight = node->weight;
+                return true;
+            }
+        }
+
+        TrieNode* child = nullptr;
+        unsigned char ch = 0;
+        if (node->childCount > TRIE_INLINE_CHILDREN) {
+            while (frame.next < 256 && !node->table[frame.next]) frame.next++;
+            if (frame.next < 256) {
+                ch = frame.next;
+                child = node->table[frame.next++];
+            }
+        } else if (frame.next < node->childCount) {
+            ch = node->keys[frame.next];
+            child = node->children[frame.next++];
+        }
+
+        if (child) {
+            it.word.push_back(ch);
+            it.stack.push_back({child, -1});
+        } else {
+            it.stack.pop_back();
+            if (!it.stack.empty()) it.word.pop_back();
+        }
+    }
+    return false;
+}
+
+// As k palavras de maior peso que começam com o prefixo, da mais pesada
+// para a mais leve. A fila de prioridade é ordenada pelo maior peso da
+// subárvore de cada nó, então uma palavra só sai da fila quando nenhum ramo
+// pendente pode ter outra mais pesada; o trabalho depende de k e da altura
+// da Trie, não do tamanho da subárvore do prefixo.
+vector<pair<string, uint32_t>> topCompletions(TrieNode* root, const string& prefix, int k) {
+    vector<pair<string, uint32_t>> result;
+    TrieNode* start = findPrefix(root, prefix);
+    if (!start || k <= 0) return result;
+
+    // Caminho de cada candidato a partir do prefixo, guardado como
+    // (passo anterior, caractere); a palavra só é montada ao entrar no resultado
+    struct Step {
+        int parent;
+        unsigned char ch;
+    };
+    struct Candidate {
+        uint32_t score;
+        bool isWord;
+        TrieNode* node;
+        int step;
+
+        // Com pesos iguais a palavra pronta sai antes do ramo
+        bool operator<(const Candidate& other) const {
+            if (score != other.score) return score < other.score;
+            return !isWord && other.isWord;
+        }
+    };
+
+    vector<Step> steps;
+    priority_queue<Candidate> queue;
+    queue.push({start->maxWeight, false, start, -1});
+
+    while (!queue.empty() && (int)result.size() < k) {
+        Candidate best = queue.top();
+        queue.pop();
+
+        if (best.isWord) {
+            string suffix;
+            for (int s = best.step; s >= 0; s = steps[s].parent) suffix.push_back(steps[s].ch);
+            result.push_back({prefix + string(suffix.rbegin(), suffix.rend()), best.score});
+            continue;
+        }
+
+        if (best.node->isEndOfWord) queue.push({best.node->weight, true, best.node, best.step});
+        forEachChild(best.node, [&](unsigned char ch, TrieNode* child) {
+            steps.push_back({best.step, ch});
+            queue.push({child->maxWeight, false, child, (int)steps.size() - 1});
+        });
+    }
+    return result;
+}
+
+// Trie concorrente para muitas leituras e poucas escritas. Os nós
+// publicados nunca mudam: uma escrita copia o caminho da raiz até a
+// palavra, altera as cópias e publica a nova raiz com um único store
+// atômico, então uma leitura nunca espera nem vê um nó pela metade. As
+// escritas são serializadas por uma trava. Os nós substituídos só são
+// liberados quando nenhum leitor pode mais alcançá-los: cada leitor anuncia
+// a época global ao começar e zera o anúncio ao terminar, e um nó retirado
+// na época t é liberado quando todos os leitores ativos anunciaram épocas
+// maiores que t.
+const int CONCURRENT_MAX_READERS = 64;
+
+struct ConcurrentTrie {
+    struct alignas(64) ReaderSlot {
+        atomic<uint64_t> epoch{0};  // 0 quando o leitor está fora de uma busca
+    };
+
+    atomic<TrieNode*> root;
+    atomic<uint64_t> epoch{1};
+    ReaderSlot readers[CONCURRENT_MAX_READERS];
+    mutex writer;
+    vector<pair<uint64_t, TrieNode*>> retired;  // (época da retirada, nó), protegido por writer
+
+    ConcurrentTrie() : root(new TrieNode()) {}
+};
+
+// Cópia privada de um nó publicado (a tabela também é copiada)
+TrieNode* copyNode(const TrieNode* node) {
+    TrieNode* clone = new TrieNode(*node);
+    if (node->childCount > TRIE_INLINE_CHILDREN) {
+        clone->table = new TrieNode*[256];
+        copy(node->table, node->table + 256, clone->table);
+    }
+    return clone;
+}
+
+// Trocar o filho de ch por outro nó (o filho precisa existir)
+void replaceChild(TrieNode* node, unsigned char ch, TrieNode* child) {
+    if (node->childCount > TRIE_INLINE_CHILDREN) {
+        node->table[ch] = child;
+        return;
+    }
+
+    for (int i = 0; i < node->childCount; i++) {
+        if (node->keys[i] == ch) node->children[i] = child;
+    }
+}
+
+void deleteNode(TrieNode* node) {
+    if (node->childCount > TRIE_INLINE_CHILDREN) delete[] node->table;
+    delete node;
+}
+
+// Nova versão do caminho com a palavra inserida; os nós antigos vão para retired
+TrieNode* insertPath(TrieNode* node, const string& word, size_t depth, vector<TrieNode*>& retired) {
+    TrieNode* copy = node ? copyNode(node) : new TrieNode();
+    if (node) retired.push_back(node);
+
+    if (depth == word.size()) {
+        copy->isEndOfWord = true;
+        copy->weight++;
+    } else {
+        unsigned char ch = word[depth];
+        TrieNode* child = node ? findChild(node, ch) : nullptr;
+        TrieNode* newChild = insertPath(child, word, depth + 1, retired);
+        if (child) replaceChild(copy, ch, newChild);
+        else addChild(copy, ch, newChild);
+    }
+
+    refreshMaxWeight(copy);
+    return copy;
+}
+
+// Nova versão do caminho sem a palavra (nullptr se o nó deixou de ser
+// necessário); a palavra precisa existir
+TrieNode* removePath(TrieNode* node, const string& word, size_t depth, vector<TrieNode*>& retired) {
+    retired.push_back(node);
+
+    TrieNode* copy = copyNode(node);
+    if (depth == word.size()) {
+        copy->isEndOfWord = false;
+        copy->weight = 0;
+    } else {
+        unsigned char ch = word[depth];
+        TrieNode* newChild = removePath(findChild(node, ch), word, depth + 1, retired);
+        if (newChild) replaceChild(copy, ch, newChild);
+        else removeChild(copy, ch);
+    }
+
+    if (depth > 0 && !copy->isEndOfWord && copy->childCount == 0) {
+        deleteNode(copy);
+        return nullptr;
+    }
+    refreshMaxWeight(copy);
+    return copy;
+}
+
+// Libera os nós retirados que nenhum leitor ativo pode estar usando
+void reclaim(ConcurrentTrie& trie) {
+    uint64_t oldest = UINT64_MAX;
+    for (auto& slot : trie.readers) {
+        uint64_t e = slot.epoch.load();
+        if (e && e < oldest) oldest = e;
+    }
+
+    size_t kept = 0;
+    for (auto& entry : trie.retired) {
+        if (entry.first < oldest) deleteNode(entry.second);
+        else trie.retired[kept++] = entry;
+    }
+    trie.retired.resize(kept);
+}
+
+// Publica a nova raiz e retira os nós substituídos na época atual
+void publish(ConcurrentTrie& trie, TrieNode* newRoot, const vector<TrieNode*>& replaced) {
+    trie.root.store(newRoot);
+    uint64_t retiredAt = trie.epoch.fetch_add(1);
+    for (TrieNode* node : replaced) trie.retired.push_back({retiredAt, node});
+    reclaim(trie);
+}
+
+// Buscar sem travas; reader identifica o leitor (0 a CONCURRENT_MAX_READERS - 1)
+// e cada thread leitora deve usar o seu
+bool search(ConcurrentTrie& trie, const string& word, int reader = 0) {
+    atomic<uint64_t>& slot = trie.readers[reader].epoch;
+    slot.store(trie.epoch.load());
+    bool found = search(trie.root.load(), word);
+    slot.store(0, memory_order_release);
+    return found;
+}
+
+void insert(ConcurrentTrie& trie, const string& word) {
+    lock_guard<mutex> guard(trie.writer);
+    vector<TrieNode*> replaced;
+    TrieNode* newRoot = insertPath(trie.root.load(), word, 0, replaced);
+    publish(trie, newRoot, replaced);
+}
+
+// Remover uma palavra; retorna se a palavra existia
+bool remove(ConcurrentTrie& trie, const string& word) {
+    lock_guard<mutex> guard(trie.writer);
+    if (!search(trie.root.load(), word)) return false;
+
+    vector<TrieNode*> replaced;
+    TrieNode* newRoot = removePath(trie.root.load(), word, 0, replaced);
+    publish(trie, newRoot, replaced);
+    return true;
+}
+
+// Liberar tudo (sem leitores ativos)
+void destroy(ConcurrentTrie* trie) {
+    for (auto& entry : trie->retired) deleteNode(entry.second);
+    destroy(trie->root.load());
+    delete trie;
+}
+
+// Nó da Trie compactada (radix/Patricia): cada aresta guarda um trecho
+// da palavra em vez de um único caractere, de modo que cadeias de nós com
+// um só filho viram um único nó. Os filhos ficam ordenados pelo primeiro
+// byte do rótulo, e esses bytes são repetidos em keys para que a busca do
+// filho não precise visitar cada um deles.
+struct RadixNode {
+    string label;
     bool isEndOfWord;
+    string keys;
+    vector<RadixNode*> children;
+
+    RadixNode(const string& text = "") : label(text), isEndOfWord(false) {}
+};
+
+// Posição do filho que começa com ch (ou onde ele deveria ser inserido)
+int childPosition(const RadixNode* node, unsigned char ch) {
+    int low = 0, high = node->keys.size();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if ((unsigned char)node->keys[mid] < ch) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+RadixNode* findChild(const RadixNode* node, unsigned char ch) {
+    const void* match = memchr(node->keys.data(), ch, node->keys.size());
+    if (!match) return nullptr;
+    return node->children[(const char*)match - node->keys.data()];
+}
+
+// Inserir uma palavra na Trie compactada
+void insert(RadixNode* root, const string& word) {
+    RadixNode* current = root;
+    size_t pos = 0;
+
+    while (pos < word.size()) {
+        int i = childPosition(current, word[pos]);
+
+        // Nenhuma aresta começa com este caractere: o resto vira uma folha
+        if (i == (int)current->keys.size() || current->keys[i] != word[pos]) {
+            RadixNode* leaf = new RadixNode(word.substr(pos));
+            leaf->isEndOfWord = true;
+            current->keys.insert(current->keys.begin() + i, word[pos]);
+            current->children.insert(current->children.begin() + i, leaf);
+            return;
+        }
+
+        RadixNode* child = current->children[i];
+        size_t common = 0;
+        while (common < child->label.size() && pos + common < word.size() &&
+               child->label[common] == word[pos + common]) {
+            common++;
+        }
+
+        // A palavra diverge no meio da aresta: divide o nó
+        if (common < child->label.size()) {
+            RadixNode* middle = new RadixNode(child->label.substr(0, common));
+            child->label.erase(0, common);
+            middle->keys.push_back(child->label[0]);
+            middle->children.push_back(child);
+            current->children[i] = middle;
+            child = middle;
+        }
+
+        current = child;
+        pos += common;
+    }
+
+    current->isEndOfWord = true;
+}
+
+// Buscar uma palavra na Trie compactada
+bool search(RadixNode* root, const string& word) {
+    RadixNode* current = root;
+    size_t pos = 0;
+
+    while (pos < word.size()) {
+        current = findChild(current, word[pos]);
+        if (!current || word.compare(pos, current->label.size(), current->label) != 0) {
+            return false;
+        }
+        pos += current->label.size();
+    }
+    return current->isEndOfWord;
+}
+
+// Junta o nó com seu único filho (usado quando ele deixa de marcar palavra)
+void mergeWithChild(RadixNode* node) {
+    RadixNode* child = node->children[0];
+    node->label += child->label;
+    node->isEndOfWord = child->isEndOfWord;
+    node->keys.swap(child->keys);
+    node->children.swap(child->children);
+    delete child;
+}
+
+// Remover uma palavra da Trie compactada; retorna se a palavra existia
+bool remove(RadixNode* current, const string& word, size_t pos = 0) {
+    if (pos == word.size()) {
+        if (!current->isEndOfWord) return false;
+        current->isEndOfWord = false;
+        return true;
+    }
+
+    int i = childPosition(current, word[pos]);
+    if (i == (int)current->keys.size() || current->keys[i] != word[pos]) return false;
+
+    RadixNode* child = current->children[i];
+    if (word.compare(pos, child->label.size(), child->label) != 0 ||
+        !remove(child, word, pos + child->label.size())) {
+        return false;
+    }
+
+    // Limpa o filho: sem palavra e sem filhos some, com um filho é fundido
+    if (!child->isEndOfWord && child->children.empty()) {
+        delete child;
+        current->keys.erase(i, 1);
+        current->children.erase(current->children.begin() + i);
+    } else if (!child->isEndOfWord && child->children.size() == 1) {
+        mergeWithChild(child);
+    }
+    return true;
+}
+
+// Liberar todos os nós da Trie compactada
+void destroy(RadixNode* node) {
+    for (RadixNode* child : node->children) {
+        destroy(child);
+    }
+    delete node;
+}
+
+// Árvore radix adaptativa (ART): os nós internos trocam de layout conforme
+// o número de filhos (Node4, Node16, Node48 e Node256) e guardam até
+// ART_MAX_PREFIX bytes do prefixo comprimido; prefixos maiores são
+// conferidos na folha. As folhas guardam a palavra inteira e são marcadas
+// no bit menos significativo do ponteiro. Toda palavra termina com um byte
+// 0 implícito, por isso as palavras não podem conter o byte 0: insert
+// recusa essas palavras e search/remove respondem false para elas (chaves
+// de tamanho fixo, como inteiros, não têm essa restrição).
+const int ART_MAX_PREFIX = 8;
+
+enum ArtNodeType : uint8_t { ART_NODE4, ART_NODE16, ART_NODE48, ART_NODE256 };
+
+struct ArtNode {
+    ArtNodeType type;
+    uint16_t childCount;
+    uint32_t prefixLength;
+    unsigned char prefix[ART_MAX_PREFIX];
+
+    ArtNode(ArtNodeType t) : type(t), childCount(0), prefixLength(0) {}
+};
+
+struct ArtNode4 : ArtNode {
+    unsigned char keys[4];
+    ArtNode* children[4];
+
+    ArtNode4() : ArtNode(ART_NODE4) {}
+};
+
+struct ArtNode16 : ArtNode {
+    unsigned char keys[16];
+    ArtNode* children[16];
+
+    ArtNode16() : ArtNode(ART_NODE16) {}
+};
+
+struct ArtNode48 : ArtNode {
+    unsigned char childIndex[256];  // posição + 1 em children (0 = sem filho)
+    ArtNode* children[48];
+
+    ArtNode48() : ArtNode(ART_NODE48) {
+        memset(childIndex, 0, sizeof(childIndex));
+        memset(children, 0, sizeof(children));
+    }
+};
+
+struct ArtNode256 : ArtNode {
+    ArtNode* children[256];
+
+    ArtNode256() : ArtNode(ART_NODE256) {
+        memset(children, 0, sizeof(children));
+    }
+};
+
+// Folha com a palavra copiada logo após o cabeçalho
+struct ArtLeaf {
+    uint32_t length;
+    char key[1];
+};
+
+struct ArtTree {
+    ArtNode* root;
+    size_t size;
+
+    ArtTree() : root(nullptr), size(0) {}
+};
+
+inline bool isLeaf(const ArtNode* node) {
+    return reinterpret_cast<uintptr_t>(node) & 1;
+}
+
+inline ArtLeaf* asLeaf(const ArtNode* node) {
+    return reinterpret_cast<ArtLeaf*>(reinterpret_cast<uintptr_t>(node) & ~(uintptr_t)1);
+}
+
+ArtNode* createLeaf(const string& word) {
+    ArtLeaf* leaf = static_cast<ArtLeaf*>(::operator new(sizeof(ArtLeaf) + word.size()));
+    leaf->length = word.size();
+    memcpy(leaf->key, word.data(), word.size());
+    return reinterpret_cast<ArtNode*>(reinterpret_cast<uintptr_t>(leaf) | 1);
+}
+
+bool leafMatches(const ArtLeaf* leaf, const string& word) {
+    return leaf->length == word.size() && memcmp(leaf->key, word.data(), word.size()) == 0;
+}
+
+// Palavras com o byte 0 colidiriam com o terminador implícito
+inline bool hasNulByte(const string& word) {
+    return word.find('\0') != string::npos;
+}
+
+// Byte da chave na profundidade indicada (0 implícito após o fim)
+inline unsigned char keyByte(const char* key, size_t length, size_t depth) {
+    return depth < length ? key[depth] : 0;
+}
+
+// Buscar o ponteiro do filho correspondente ao byte (nullptr se não existir)
+ArtNode** findChild(ArtNode* node, unsigned char ch) {
+    switch (node->type) {
+        case ART_NODE4: {
+            ArtNode4* n = static_cast<ArtNode4*>(node);
+            for (int i = 0; i < n->childCount; i++) {
+                if (n->keys[i] == ch) return &n->children[i];
+            }
+            return nullptr;
+        }
+        case ART_NODE16: {
+            ArtNode16* n = static_cast<ArtNode16*>(node);
+#ifdef __SSE2__
+            // Compara o byte com as 16 chaves de uma vez
+            __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys));
+            __m128i match = _mm_cmpeq_epi8(keys, _mm_set1_epi8(ch));
+            int bits = _mm_movemask_epi8(match) & ((1 << n->childCount) - 1);
+            return bits ? &n->children[__builtin_ctz(bits)] : nullptr;
+#else
+            for (int i = 0; i < n->childCount; i++) {
+                if (n->keys[i] == ch) return &n->children[i];
+            }
+            return nullptr;
+#endif
+        }
+        case ART_NODE48: {
+            ArtNode48* n = static_cast<ArtNode48*>(node);
+            int index = n->childIndex[ch];
+            return index ? &n->children[index - 1] : nullptr;
+        }
+        case ART_NODE256: {
+            ArtNode256* n = static_cast<ArtNode256*>(node);
+            return n->children[ch] ? &n->children[ch] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+// Percorre os filhos em ordem crescente de byte
+template <typename Visitor>
+void forEachChild(ArtNode* node, Visitor visit) {
+    switch (node->type) {
+        case ART_NODE4: {
+            ArtNode4* n = static_cast<ArtNode4*>(node);
+            for (int i = 0; i < n->childCount; i++) visit(n->keys[i], n->children[i]);
+            break;
+        }
+        case ART_NODE16: {
+            ArtNode16* n = static_cast<ArtNode16*>(node);
+            for (int i = 0; i < n->childCount; i++) visit(n->keys[i], n->children[i]);
+            break;
+        }
+        case ART_NODE48: {
+            ArtNode48* n = static_cast<ArtNode48*>(node);
+            for (int c = 0; c < 256; c++) {
+                if (n->childIndex[c]) visit((unsigned char)c, n->children[n->childIndex[c] - 1]);
+            }
+            break;
+        }
+        case ART_NODE256: {
+            ArtNode256* n = static_cast<ArtNode256*>(node);
+            for (int c = 0; c < 256; c++) {
+                if (n->children[c]) visit((unsigned char)c, n->children[c]);
+            }
+            break;
+        }
+    }
+}
+
+// Folha mais à esquerda da subárvore (fornece os bytes do prefixo que não
+// couberam no nó)
+const ArtLeaf* minimumLeaf(ArtNode* node) {
+    while (!isLeaf(node)) {
+        ArtNode* first = nullptr;
+        forEachChild(node, [&](unsigned char, ArtNode* child) {
+            if (!first) first = child;
+        });
+        node = first;
+    }
+    return asLeaf(node);
+}
+
+void copyHeader(ArtNode* to, const ArtNode* from) {
+    to->childCount = from->childCount;
+    to->prefixLength = from->prefixLength;
+    memcpy(to->prefix, from->prefix, ART_MAX_PREFIX);
+}
+
+// Insere o filho num vetor ordenado de chaves (Node4 e Node16)
+void insertSorted(unsigned char* keys, ArtNode** children, int count, unsigned char ch, ArtNode* child) {
+    int i = count;
+    while (i > 0 && keys[i - 1] > ch) {
+        keys[i] = keys[i - 1];
+        children[i] = children[i - 1];
+        i--;
+    }
+    keys[i] = ch;
+    children[i] = child;
+}
+
+// Adicionar um filho; se o nó estiver cheio ele é trocado pelo próximo
+// tamanho e *ref passa a apontar para o novo nó
+void addChild(ArtNode** ref, ArtNode* node, unsigned char ch, ArtNode* child) {
+    switch (node->type) {
+        case ART_NODE4: {
+            ArtNode4* n = static_cast<ArtNode4*>(node);
+            if (n->childCount < 4) {
+                insertSorted(n->keys, n->children, n->childCount, ch, child);
+                n->childCount++;
+                return;
+            }
+
+            ArtNode16* bigger = new ArtNode16();
+            copyHeader(bigger, n);
+            memcpy(bigger->keys, n->keys, 4);
+            memcpy(bigger->children, n->children, 4 * sizeof(ArtNode*));
+            *ref = bigger;
+            delete n;
+            addChild(ref, bigger, ch, child);
+            return;
+        }
+        case ART_NODE16: {
+            ArtNode16* n = static_cast<ArtNode16*>(node);
+            if (n->childCount < 16) {
+                insertSorted(n->keys, n->children, n->childCount, ch, child);
+                n->childCount++;
+                return;
+            }
+
+            ArtNode48* bigger = new ArtNode48();
+            copyHeader(bigger, n);
+            for (int i = 0; i < 16; i++) {
+                bigger->childIndex[n->keys[i]] = i + 1;
+                bigger->children[i] = n->children[i];
+            }
+            *ref = bigger;
+            delete n;
+            addChild(ref, bigger, ch, child);
+            return;
+        }
+        case ART_NODE48: {
+            ArtNode48* n = static_cast<ArtNode48*>(node);
+            if (n->childCount < 48) {
+                int slot = 0;
+                while (n->children[slot]) slot++;
+                n->children[slot] = child;
+                n->childIndex[ch] = slot + 1;
+                n->childCount++;
+                return;
+            }
+
+            ArtNode256* bigger = new ArtNode256();
+            copyHeader(bigger, n);
+            for (int c = 0; c < 256; c++) {
+                if (n->childIndex[c]) bigger->children[c] = n->children[n->childIndex[c] - 1];
+            }
+            *ref = bigger;
+            delete n;
+            addChild(ref, bigger, ch, child);
+            return;
+        }
+        case ART_NODE256: {
+            ArtNode256* n = static_cast<ArtNode256*>(node);
+            n->children[ch] = child;
+            n->childCount++;
+            return;
+        }
+    }
+}
+
+// Remove um filho de um vetor ordenado de chaves (Node4 e Node16)
+void eraseSorted(unsigned char* keys, ArtNode** children, int count, int position) {
+    for (int i = position; i + 1 < count; i++) {
+        keys[i] = keys[i + 1];
+        children[i] = children[i + 1];
+    }
+}
+
+// Desligar o filho apontado por slot; nós que ficam pequenos demais são
+// trocados pelo tamanho anterior e um Node4 com um só filho é fundido a ele
+void removeChild(ArtNode** ref, ArtNode* node, unsigned char ch, ArtNode** slot) {
+    switch (node->type) {
+        case ART_NODE4: {
+            ArtNode4* n = static_cast<ArtNode4*>(node);
+            eraseSorted(n->keys, n->children, n->childCount, slot - n->children);
+            n->childCount--;
+            if (n->childCount > 1) return;
+
+            // Um só filho: o prefixo do nó e o byte da aresta passam para ele
+            ArtNode* child = n->children[0];
+            if (!isLeaf(child)) {
+                unsigned char merged[ART_MAX_PREFIX];
+                int length = min<int>(n->prefixLength, ART_MAX_PREFIX);
+                memcpy(merged, n->prefix, length);
+                if (length < ART_MAX_PREFIX) merged[length++] = n->keys[0];
+
+                int fromChild = min<int>(child->prefixLength, ART_MAX_PREFIX - length);
+                memcpy(merged + length, child->prefix, fromChild);
+                length += fromChild;
+
+                memcpy(child->prefix, merged, length);
+                child->prefixLength += n->prefixLength + 1;
+            }
+            *ref = child;
+            delete n;
+            return;
+        }
+        case ART_NODE16: {
+            ArtNode16* n = static_cast<ArtNode16*>(node);
+            eraseSorted(n->keys, n->children, n->childCount, slot - n->children);
+            n->childCount--;
+            if (n->childCount > 3) return;
+
+            ArtNode4* smaller = new ArtNode4();
+            copyHeader(smaller, n);
+            memcpy(smaller->keys, n->keys, n->childCount);
+            memcpy(smaller->children, n->children, n->childCount * sizeof(ArtNode*));
+            *ref = smaller;
+            delete n;
+            return;
+        }
+        case ART_NODE48: {
+            ArtNode48* n = static_cast<ArtNode48*>(node);
+            *slot = nullptr;
+            n->childIndex[ch] = 0;
+            n->childCount--;
+            if (n->childCount > 12) return;
+
+            ArtNode16* smaller = new ArtNode16();
+            copyHeader(smaller, n);
+            int i = 0;
+            for (int c = 0; c < 256; c++) {
+                if (n->childIndex[c]) {
+                    smaller->keys[i] = c;
+                    smaller->children[i] = n->children[n->childIndex[c] - 1];
+                    i++;
+                }
+            }
+            *ref = smaller;
+            delete n;
+            return;
+        }
+        case ART_NODE256: {
+            ArtNode256* n = static_cast<ArtNode256*>(node);
+            *slot = nullptr;
+            n->childCount--;
+            if (n->childCount > 37) return;
+
+            ArtNode48* smaller = new ArtNode48();
+            copyHeader(smaller, n);
+            int i = 0;
+            for (int c = 0; c < 256; c++) {
+                if (n->children[c]) {
+                    smaller->childIndex[c] = i + 1;
+                    smaller->children[i] = n->children[c];
+                    i++;
+                }
+            }
+            *ref = smaller;
+            delete n;
+            return;
+        }
+    }
+}
+
+// Quantos bytes do prefixo do nó coincidem com a chave a partir de depth
+int prefixMismatch(ArtNode* node, const string& word, size_t depth) {
+    int stored = min<int>(node->prefixLength, ART_MAX_PREFIX);
+    int i = 0;
+    for (; i < stored; i++) {
+        if (node->prefix[i] != keyByte(word.data(), word.size(), depth + i)) return i;
+    }
+
+    // O restante do prefixo só existe nas folhas
+    if ((int)node->prefixLength > ART_MAX_PREFIX) {
+        const ArtLeaf* leaf = minimumLeaf(node);
+        for (; i < (int)node->prefixLength; i++) {
+            if (keyByte(leaf->key, leaf->length, depth + i) != keyByte(word.data(), word.size(), depth + i)) return i;
+        }
+    }
+    return i;
+}
+
+// Inserir uma palavra na ART; retorna false se ela já existia ou se contém
+// o byte 0
+bool insert(ArtTree* tree, const string& word) {
+    if (hasNulByte(word)) return false;
+    ArtNode** ref = &tree->root;
+    size_t depth = 0;
+
+    while (true) {
+        ArtNode* node = *ref;
+        if (!node) {
+            *ref = createLeaf(word);
+            tree->size++;
+            return true;
+        }
+
+        // Encontrou outra folha: as duas passam a ser filhas de um Node4
+        // cujo prefixo é o trecho em comum
+        if (isLeaf(node)) {
+            const ArtLeaf* existing = asLeaf(node);
+            if (leafMatches(existing, word)) return false;
+
+            size_t limit = max<size_t>(existing->length, word.size());
+            size_t common = 0;
+            while (depth + common < limit &&
+                   keyByte(existing->key, existing->length, depth + common) == keyByte(word.data(), word.size(), depth + common)) {
+                common++;
+            }
+
+            ArtNode4* split = new ArtNode4();
+            split->prefixLength = common;
+            memcpy(split->prefix, word.data() + depth, min<size_t>(common, ART_MAX_PREFIX));
+            addChild(ref, split, keyByte(existing->key, existing->length, depth + common), node);
+            addChild(ref, split, keyByte(word.data(), word.size(), depth + common), createLeaf(word));
+            *ref = split;
+            tree->size++;
+            return true;
+        }
+
+        // A palavra diverge no meio do prefixo: cria um Node4 acima do nó
+        if (node->prefixLength) {
+            int diff = prefixMismatch(node, word, depth);
+            if (diff < (int)node->prefixLength) {
+                ArtNode4* split = new ArtNode4();
+                split->prefixLength = diff;
+                memcpy(split->prefix, node->prefix, min(diff, ART_MAX_PREFIX));
+
+                unsigned char edge;
+                if (node->prefixLength <= ART_MAX_PREFIX) {
+                    edge = node->prefix[diff];
+                    node->prefixLength -= diff + 1;
+                    memmove(node->prefix, node->prefix + diff + 1, node->prefixLength);
+                } else {
+                    const ArtLeaf* leaf = minimumLeaf(node);
+                    edge = keyByte(leaf->key, leaf->length, depth + diff);
+                    node->prefixLength -= diff + 1;
+                    memcpy(node->prefix, leaf->key + depth + diff + 1, min<int>(node->prefixLength, ART_MAX_PREFIX));
+                }
+
+                addChild(ref, split, edge, node);
+                addChild(ref, split, keyByte(word.data(), word.size(), depth + diff), createLeaf(word));
+                *ref = split;
+                tree->size++;
+                return true;
+            }
+            depth += node->prefixLength;
+        }
+
+        unsigned char ch = keyByte(word.data(), word.size(), depth);
+        ArtNode** slot = findChild(node, ch);
+        if (!slot) {
+            addChild(ref, node, ch, createLeaf(word));
+            tree->size++;
+            return true;
+        }
+
+        ref = slot;
+        depth++;
+    }
+}
+
+// Buscar uma palavra na ART. O prefixo é conferido só nos bytes guardados
+// no nó; a comparação final com a folha resolve o restante.
+bool search(ArtTree* tree, const string& word) {
+    if (hasNulByte(word)) return false;
+    ArtNode* node = tree->root;
+    size_t depth = 0;
+
+    while (node) {
+        if (isLeaf(node)) {
+            return leafMatches(asLeaf(node), word);
+        }
+
+        if (node->prefixLength) {
+            int stored = min<int>(node->prefixLength, ART_MAX_PREFIX);
+            for (int i = 0; i < stored; i++) {
+                if (node->prefix[i] != keyByte(word.data(), word.size(), depth + i)) return false;
+            }
+            depth += node->prefixLength;
+        }
+
+        if (depth > word.size()) return false;
+
+        ArtNode** slot = findChild(node, keyByte(word.data(), word.size(), depth));
+        node = slot ? *slot : nullptr;
+        depth++;
+    }
+    return false;
+}
+
+// Remover uma palavra da ART; retorna se a palavra existia
+bool remove(ArtTree* tree, const string& word) {
+    if (hasNulByte(word)) return false;
+    ArtNode** ref = &tree->root;
+    ArtNode* node = *ref;
+    if (!node) return false;
+
+    if (isLeaf(node)) {
+        if (!leafMatches(asLeaf(node), word)) return false;
+        ::operator delete(asLeaf(node));
+        tree->root = nullptr;
+        tree->size--;
+        return true;
+    }
+
+    size_t depth = 0;
+    while (true) {
+        if (node->prefixLength) {
+            if (prefixMismatch(node, word, depth) != (int)node->prefixLength) return false;
+            depth += node->prefixLength;
+        }
+        if (depth > word.size()) return false;
+
+        unsigned char ch = keyByte(word.data(), word.size(), depth);
+        ArtNode** slot = findChild(node, ch);
+        if (!slot) return false;
+
+        ArtNode* child = *slot;
+        if (isLeaf(child)) {
+            if (!leafMatches(asLeaf(child), word)) return false;
+            removeChild(ref, node, ch, slot);
+            ::operator delete(asLeaf(child));
+            tree->size--;
+            return true;
+        }
+
+        ref = slot;
+        node = child;
+        depth++;
+    }
+}
+
+// Liberar todos os nós da ART
+void destroy(ArtNode* node) {
+    if (isLeaf(node)) {
+        ::operator delete(asLeaf(node));
+        return;
+    }
+
+    forEachChild(node, [](unsigned char, ArtNode* child) { destroy(child); });
+
+    switch (node->type) {
+        case ART_NODE4: delete static_cast<ArtNode4*>(node); break;
+        case ART_NODE16: delete static_cast<ArtNode16*>(node); break;
+        case ART_NODE48: delete static_cast<ArtNode48*>(node); break;
+        case ART_NODE256: delete static_cast<ArtNode256*>(node); break;
+    }
+}
+
+void destroy(ArtTree* tree) {
+    if (tree->root) destroy(tree->root);
+    delete tree;
+}
+
+// Trie congelada no formato LOUDS (Level-Order Unary Degree Sequence): os
+// nós são numerados em largura e cada um escreve um bit 1 por filho seguido
+// de um 0. Os filhos do nó v são os 1s entre o (v-1)-ésimo e o v-ésimo 0,
+// então localizar um nó é um select0 sobre a sequência. Os rótulos das
+// arestas ficam num vetor de bytes na mesma ordem (o do nó c em labels[c-1])
+// e as palavras terminadas num bitvector indexado pelo nó. O arquivo é
+// gravado uma vez a partir de uma Trie por caractere e depois mapeado com
+// mmap somente leitura: as consultas leem direto das páginas do arquivo,
+// sem construir nenhum nó.
+const char LOUDS_MAGIC[8] = {'L', 'O', 'U', 'D', 'S', 'T', 'R', '1'};
+const uint64_t LOUDS_BLOCK_BITS = 512;     // bits por entrada do diretório de rank
+const uint64_t LOUDS_SELECT_SAMPLE = 512;  // zeros entre duas amostras do select
+
+struct LoudsHeader {
+    char magic[8];
+    uint64_t nodeCount;
+    uint64_t bitCount;
+};
+
+// Seções do arquivo, todas alinhadas em 8 bytes a partir do cabeçalho
+struct LoudsLayout {
+    size_t bits, zerosBefore, samples, terminal, labels, total;
+};
+
+struct LoudsTrie {
+    const uint64_t* bits;         // sequência LOUDS
+    const uint32_t* zerosBefore;  // zeros antes de cada bloco de 512 bits
+    const uint32_t* samples;      // bloco do zero número i * LOUDS_SELECT_SAMPLE
+    const uint64_t* terminal;     // bit do nó ligado se ele termina uma palavra
+    const unsigned char* labels;  // rótulo da aresta que chega a cada nó
+    uint64_t nodeCount;
+    uint64_t bitCount;
+    void* mapping;
+    size_t mappingSize;
+
+    LoudsTrie() : nodeCount(0), bitCount(0), mapping(nullptr), mappingSize(0) {}
+};
+
+size_t loudsAlign(size_t bytes) {
+    return (bytes + 7) & ~(size_t)7;
+}
+
+LoudsLayout loudsLayout(uint64_t nodeCount, uint64_t bitCount) {
+    uint64_t blocks = (bitCount + LOUDS_BLOCK_BITS - 1) / LOUDS_BLOCK_BITS;
+
+    LoudsLayout layout;
+    layout.bits = sizeof(LoudsHeader);
+    layout.zerosBefore = layout.bits + (bitCount + 63) / 64 * 8;
+    layout.samples = layout.zerosBefore + loudsAlign((blocks + 1) * sizeof(uint32_t));
+    layout.terminal = layout.samples + loudsAlign((nodeCount / LOUDS_SELECT_SAMPLE + 1) * sizeof(uint32_t));
+    layout.labels = layout.terminal + (nodeCount + 63) / 64 * 8;
+    layout.total = layout.labels + nodeCount - 1;
+    return layout;
+}
+
+// Posição do i-ésimo 0 (contando do zero): a amostra indica o bloco de
+// partida, o diretório de rank acha o bloco certo e o popcount a palavra
+uint64_t select0(const LoudsTrie& trie, uint64_t i) {
+    uint64_t block = trie.samples[i / LOUDS_SELECT_SAMPLE];
+    while (trie.zerosBefore[block + 1] <= i) block++;
+
+    uint64_t remaining = i - trie.zerosBefore[block];
+    uint64_t w = block * (LOUDS_BLOCK_BITS / 64);
+    uint64_t zeros = ~trie.bits[w];
+    while (remaining >= (uint64_t)__builtin_popcountll(zeros)) {
+        remaining -= __builtin_popcountll(zeros);
+        zeros = ~trie.bits[++w];
+    }
+
+    while (remaining--) zeros &= zeros - 1;
+    return w * 64 + __builtin_ctzll(zeros);
+}
+
+// Posição do primeiro 0 a partir de pos (o fim do bloco de um nó)
+uint64_t nextZero(const LoudsTrie& trie, uint64_t pos) {
+    uint64_t w = pos / 64;
+    uint64_t zeros = ~trie.bits[w] & (~0ULL << (pos % 64));
+    while (!zeros) zeros = ~trie.bits[++w];
+    return w * 64 + __builtin_ctzll(zeros);
+}
+
+// Primeiro filho e grau do nó: antes do bloco do nó v há v zeros, então o
+// primeiro 1 do bloco é o filho número start - v + 1
+void childRange(const LoudsTrie& trie, uint64_t node, uint64_t& first, uint64_t& degree) {
+    uint64_t start = node == 0 ? 0 : select0(trie, node - 1) + 1;
+    degree = nextZero(trie, start) - start;
+    first = start - node + 1;
+}
+
+bool isTerminal(const LoudsTrie& trie, uint64_t node) {
+    return trie.terminal[node / 64] >> (node % 64) & 1;
+}
+
+// Filho do nó com o rótulo ch (-1 se não existir)
+int64_t findChild(const LoudsTrie& trie, uint64_t node, unsigned char ch) {
+    uint64_t first, degree;
+    childRange(trie, node, first, degree);
+
+    const void* match = memchr(trie.labels + first - 1, ch, degree);
+    if (!match) return -1;
+    return first + ((const unsigned char*)match - (trie.labels + first - 1));
+}
+
+template <typename Visitor>
+void forEachChild(const LoudsTrie& trie, uint64_t node, Visitor visit) {
+    uint64_t first, degree;
+    childRange(trie, node, first, degree);
+    for (uint64_t c = first; c < first + degree; c++) {
+        visit(trie.labels[c - 1], c);
+    }
+}
+
+// Gravar a Trie por caractere no formato LOUDS
+bool saveLoudsSnapshot(TrieNode* root, const string& filename) {
+    // Percurso em largura; a fila também define a numeração dos nós
+    vector<TrieNode*> order(1, root);
+    vector<unsigned char> labels;
+    vector<uint64_t> bits;
+    uint64_t bitCount = 0;
+
+    auto pushBit = [&](bool one) {
+        if (bitCount % 64 == 0) bits.push_back(0);
+        if (one) bits.back() |= 1ULL << (bitCount % 64);
+        bitCount++;
+    };
+
+    for (size_t i = 0; i < order.size(); i++) {
+        forEachChild(order[i], [&](unsigned char ch, TrieNode* child) {
+            order.push_back(child);
+            labels.push_back(ch);
+            pushBit(true);
+        });
+        pushBit(false);
+    }
+
+    uint64_t nodeCount = order.size();
+    vector<uint64_t> terminal((nodeCount + 63) / 64);
+    for (uint64_t v = 0; v < nodeCount; v++) {
+        if (order[v]->isEndOfWord) terminal[v / 64] |= 1ULL << (v % 64);
+    }
+
+    // Diretório de rank (zeros antes de cada bloco) e amostras do select
+    uint64_t blocks = (bitCount + LOUDS_BLOCK_BITS - 1) / LOUDS_BLOCK_BITS;
+    vector<uint32_t> zerosBefore(blocks + 1);
+    vector<uint32_t> samples;
+    uint64_t zeros = 0;
+    for (uint64_t pos = 0; pos < bitCount; pos++) {
+        if (pos % LOUDS_BLOCK_BITS == 0) zerosBefore[pos / LOUDS_BLOCK_BITS] = zeros;
+        if (!(bits[pos / 64] >> (pos % 64) & 1)) {
+            if (zeros % LOUDS_SELECT_SAMPLE == 0) samples.push_back(pos / LOUDS_BLOCK_BITS);
+            zeros++;
+        }
+    }
+    zerosBefore[blocks] = zeros;
+
+    ofstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Erro ao abrir o arquivo!\n";
+        return false;
+    }
+
+    LoudsHeader header;
+    memcpy(header.magic, LOUDS_MAGIC, sizeof(header.magic));
+    header.nodeCount = nodeCount;
+    header.bitCount = bitCount;
+
+    LoudsLayout layout = loudsLayout(nodeCount, bitCount);
+    auto writeAt = [&](size_t offset, const void* data, size_t bytes) {
+        while ((size_t)file.tellp() < offset) file.put('\0');
+        file.write((const char*)data, bytes);
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(layout.bits, bits.data(), bits.size() * sizeof(uint64_t));
+    writeAt(layout.zerosBefore, zerosBefore.data(), zerosBefore.size() * sizeof(uint32_t));
+    writeAt(layout.samples, samples.data(), samples.size() * sizeof(uint32_t));
+    writeAt(layout.terminal, terminal.data(), terminal.size() * sizeof(uint64_t));
+    writeAt(layout.labels, labels.data(), labels.size());
+
+    return file.good();
+}
+
+// Mapear um snapshot gravado por saveLoudsSnapshot (somente leitura)
+bool openLoudsSnapshot(const string& filename, LoudsTrie& trie) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || (size_t)info.st_size < sizeof(LoudsHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    // Cabeçalho de um arquivo corrompido ou de outro formato: o número de
+    // nós é limitado primeiro (os diretórios são de 32 bits), então o
+    // tamanho calculado pelo layout não transborda. Cada nó tem um bit 0 e
+    // cada nó fora a raiz tem um bit 1, o que fixa o total de bits
+    const char* base = (const char*)mapping;
+    const LoudsHeader* header = (const LoudsHeader*)base;
+    bool valid = memcmp(header->magic, LOUDS_MAGIC, sizeof(header->magic)) == 0 && header->nodeCount > 0 &&
+                 header->nodeCount <= UINT32_MAX && header->bitCount == 2 * header->nodeCount - 1;
+    LoudsLayout layout;
+    if (valid) {
+        layout = loudsLayout(header->nodeCount, header->bitCount);
+        valid = layout.total <= (size_t)info.st_size;
+    }
+    if (valid) {
+        // O diretório de rank termina com o total de zeros, um por nó
+        uint64_t blocks = (header->bitCount + LOUDS_BLOCK_BITS - 1) / LOUDS_BLOCK_BITS;
+        valid = ((const uint32_t*)(base + layout.zerosBefore))[blocks] == header->nodeCount;
+    }
+    if (!valid) {
+        munmap(mapping, info.st_size);
+        return false;
+    }
+
+    trie.bits = (const uint64_t*)(base + layout.bits);
+    trie.zerosBefore = (const uint32_t*)(base + layout.zerosBefore);
+    trie.samples = (const uint32_t*)(base + layout.samples);
+    trie.terminal = (const uint64_t*)(base + layout.terminal);
+    trie.labels = (const unsigned char*)(base + layout.labels);
+    trie.nodeCount = header->nodeCount;
+    trie.bitCount = header->bitCount;
+    trie.mapping = mapping;
+    trie.mappingSize = info.st_size;
+    return true;
+}
+
+void closeLoudsSnapshot(LoudsTrie& trie) {
+    if (trie.mapping) munmap(trie.mapping, trie.mappingSize);
+    trie.mapping = nullptr;
+}
+
+// Nó onde termina o prefixo (-1 se nenhuma palavra começa com ele)
+int64_t findPrefix(const LoudsTrie& trie, const string& prefix) {
+    int64_t node = 0;
+    for (unsigned char ch : prefix) {
+        node = findChild(trie, node, ch);
+        if (node < 0) return -1;
+    }
+    return node;
+}
+
+bool search(const LoudsTrie& trie, const string& word) {
+    int64_t node = findPrefix(trie, word);
+    return node >= 0 && isTerminal(trie, node);
+}
+
+bool startsWith(const LoudsTrie& trie, const string& prefix) {
+    int64_t node = findPrefix(trie, prefix);
+    if (node < 0) return false;
+
+    uint64_t first, degree;
+    childRange(trie, node, first, degree);
+    return isTerminal(trie, node) || degree > 0;
+}
+
+// Trie de vetor duplo (double-array): cada estado é um índice e a transição
+// de s pelo byte ch vai para t = base[s] + código(ch), válida se check[t]
+// for s. Uma transição custa duas leituras de vetor e nenhum ponteiro. Os
+// códigos vão de 1 a 256 (byte + 1), o estado 0 é a raiz e check = -1
+// marca posições livres. Quando o novo filho colide com outro estado, os
+// filhos de s são realocados para uma base em que todos cabem. A busca de
+// bases livres só olha as últimas DA_SEARCH_WINDOW posições usadas: os
+// buracos mais antigos ainda recebem filhos que caiam neles, mas varrê-los
+// a cada inserção tornaria a construção quadrática.
+const int DA_ALPHABET = 256;
+const int32_t DA_SEARCH_WINDOW = 4096;
+
+struct DoubleArrayTrie {
+    vector<int32_t> base;
+    vector<int32_t> check;
+    vector<uint8_t> terminal;
+    int32_t firstFree;  // primeira posição livre dentro da janela de busca
+    int32_t used;       // uma depois da maior posição já ocupada
+
+    DoubleArrayTrie() : base(1, 0), check(1, 0), terminal(1, 0), firstFree(1), used(1) {}
+};
+
+inline int daCode(unsigned char ch) {
+    return ch + 1;
+}
+
+// Estado alcançado a partir de s pelo byte ch (-1 se não existir)
+inline int32_t findChild(const DoubleArrayTrie& trie, int32_t state, unsigned char ch) {
+    if (!trie.base[state]) return -1;
+    size_t next = trie.base[state] + daCode(ch);
+    return next < trie.check.size() && trie.check[next] == state ? (int32_t)next : -1;
+}
+
+// Percorre os filhos em ordem crescente de caractere
+template <typename Visitor>
+void forEachChild(const DoubleArrayTrie& trie, int32_t state, Visitor visit) {
+    int32_t base = trie.base[state];
+    if (!base) return;
+
+    size_t last = min(trie.check.size(), (size_t)base + DA_ALPHABET + 1);
+    for (size_t next = base + 1; next < last; next++) {
+        if (trie.check[next] == state) visit((unsigned char)(next - base - 1), (int32_t)next);
+    }
+}
+
+void reserveStates(DoubleArrayTrie& trie, size_t size) {
+    if (size <= trie.check.size()) return;
+
+    size = max(size, trie.check.size() * 2);
+    trie.base.resize(size, 0);
+    trie.check.resize(size, -1);
+    trie.terminal.resize(size, 0);
+}
+
+void occupyState(DoubleArrayTrie& trie, int32_t state, int32_t parent) {
+    trie.check[state] = parent;
+    trie.used = max(trie.used, state + 1);
+    trie.firstFree = max(trie.firstFree, trie.used - DA_SEARCH_WINDOW);
+    while ((size_t)trie.firstFree < trie.check.size() && trie.check[trie.firstFree] >= 0) trie.firstFree++;
+}
+
+void freeState(DoubleArrayTrie& trie, int32_t state) {
+    trie.base[state] = 0;
+    trie.check[state] = -1;
+    trie.terminal[state] = 0;
+    if (state < trie.firstFree && state >= trie.used - DA_SEARCH_WINDOW) trie.firstFree = state;
+}
+
+// Menor base em que todos os códigos (em ordem crescente) caem em posições
+// livres, procurada dentro da janela de busca
+int32_t findBase(DoubleArrayTrie& trie, const vector<int>& codes) {
+    for (int32_t pos = max(trie.firstFree, codes[0] + 1);; pos++) {
+        reserveStates(trie, pos + 1);
+        if (trie.check[pos] >= 0) continue;
+
+        int32_t base = pos - codes[0];
+        reserveStates(trie, base + codes.back() + 1);
+
+        bool fits = true;
+        for (size_t i = 1; i < codes.size() && fits; i++) {
+            fits = trie.check[base + codes[i]] < 0;
+        }
+        if (fits) return base;
+    }
+}
+
+// Move os filhos de s para uma base onde também cabe o código extra
+void relocate(DoubleArrayTrie& trie, int32_t state, int extraCode) {
+    vector<int> codes;
+    forEachChild(trie, state, [&](unsigned char ch, int32_t) { codes.push_back(daCode(ch)); });
+    codes.insert(lower_bound(codes.begin(), codes.end(), extraCode), extraCode);
+
+    int32_t oldBase = trie.base[state];
+    int32_t newBase = findBase(trie, codes);
+
+    for (int code : codes) {
+        if (code == extraCode) continue;
+
+        int32_t from = oldBase + code, to = newBase + code;
+        trie.base[to] = trie.base[from];
+        trie.terminal[to] = trie.terminal[from];
+        occupyState(trie, to, state);
+
+        // Os netos passam a apontar para a nova posição do filho
+        forEachChild(trie, from, [&](unsigned char, int32_t grandchild) { trie.check[grandchild] = to; });
+        freeState(trie, from);
+    }
+    trie.base[state] = newBase;
+}
+
+// Cria o filho de s pelo byte ch e retorna o novo estado
+int32_t addChild(DoubleArrayTrie& trie, int32_t state, unsigned char ch) {
+    int code = daCode(ch);
+
+    if (!trie.base[state]) {
+        trie.base[state] = findBase(trie, vector<int>(1, code));
+    } else {
+        reserveStates(trie, trie.base[state] + code + 1);
+        if (trie.check[trie.base[state] + code] >= 0) relocate(trie, state, code);
+    }
+
+    int32_t next = trie.base[state] + code;
+    occupyState(trie, next, state);
+    return next;
+}
+
+// Inserir uma palavra (inserção incremental)
+void insert(DoubleArrayTrie* trie, const string& word) {
+    int32_t state = 0;
+    for (unsigned char ch : word) {
+        int32_t next = findChild(*trie, state, ch);
+        state = next >= 0 ? next : addChild(*trie, state, ch);
+    }
+    trie->terminal[state] = 1;
+}
+
+// Construção estática a partir de palavras ordenadas e sem repetição: os
+// filhos de cada estado são conhecidos de uma vez, então cada base é
+// escolhida uma única vez e nada é realocado
+void buildDoubleArray(DoubleArrayTrie& trie, const vector<string>& words, size_t low, size_t high,
+                      size_t depth = 0, int32_t state = 0) {
+    if (low < high && words[low].size() == depth) {
+        trie.terminal[state] = 1;
+        low++;
+    }
+    if (low == high) return;
+
+    vector<int> codes;
+    for (size_t i = low; i < high; i++) {
+        int code = daCode(words[i][depth]);
+        if (codes.empty() || codes.back() != code) codes.push_back(code);
+    }
+
+    int32_t base = findBase(trie, codes);
+    trie.base[state] = base;
+    for (int code : codes) occupyState(trie, base + code, state);
+
+    size_t begin = low;
+    for (int code : codes) {
+        size_t end = begin;
+        while (end < high && daCode(words[end][depth]) == code) end++;
+        buildDoubleArray(trie, words, begin, end, depth + 1, base + code);
+        begin = end;
+    }
+}
+
+void buildDoubleArray(DoubleArrayTrie& trie, const vector<string>& sortedWords) {
+    buildDoubleArray(trie, sortedWords, 0, sortedWords.size());
+}
+
+// Estado onde termina o prefixo (-1 se nenhuma palavra começa com ele)
+int32_t findPrefix(const DoubleArrayTrie& trie, const string& prefix) {
+    int32_t state = 0;
+    for (unsigned char ch : prefix) {
+        state = findChild(trie, state, ch);
+        if (state < 0) return -1;
+    }
+    return state;
+}
+
+bool search(DoubleArrayTrie* trie, const string& word) {
+    int32_t state = findPrefix(*trie, word);
+    return state >= 0 && trie->terminal[state];
+}
+
+// Remover uma palavra; estados que ficam sem palavra e sem filhos são
+// devolvidos. Retorna se a palavra existia.
+bool remove(DoubleArrayTrie* trie, const string& word) {
+    int32_t state = findPrefix(*trie, word);
+    if (state < 0 || !trie->terminal[state]) return false;
+
+    trie->terminal[state] = 0;
+    while (state != 0 && !trie->terminal[state]) {
+        bool hasChildren = false;
+        forEachChild(*trie, state, [&](unsigned char, int32_t) { hasChildren = true; });
+        if (hasChildren) break;
+
+        int32_t parent = trie->check[state];
+        freeState(*trie, state);
+        state = parent;
+    }
+    return true;
+}
+
+void destroy(DoubleArrayTrie* trie) {
+    delete trie;
+}
+
+// Exibir palavras armazenadas na Trie
+void display(TrieNode* root, string& prefix) {
+    if (root->isEndOfWord) {
+        cout << prefix << endl;
+    }
+
+    forEachChild(root, [&](unsigned char ch, TrieNode* child) {
+        prefix.push_back(ch);
+        display(child, prefix);
+        prefix.pop_back();
+    });
+}
+
+void display(RadixNode* root, string& prefix) {
+    if (root->isEndOfWord) {
+        cout << prefix << endl;
+    }
+
+    for (RadixNode* child : root->children) {
+        prefix += child->label;
+        display(child, prefix);
+        prefix.resize(prefix.size() - child->label.size());
+    }
+}
+
+void display(ArtNode* node) {
+    if (isLeaf(node)) {
+        const ArtLeaf* leaf = asLeaf(node);
+        cout.write(leaf->key, leaf->length) << endl;
+        return;
+    }
+
+    forEachChild(node, [](unsigned char, ArtNode* child) { display(child); });
+}
+
+void display(const DoubleArrayTrie& trie, int32_t state, string& prefix) {
+    if (trie.terminal[state]) {
+        cout << prefix << endl;
+    }
 
-    TrieNode() : isEndOfWord(false) {}
-};
+    forEachChild(trie, state, [&](unsigned char ch, int32_t child) {
+        prefix.push_back(ch);
+        display(trie, child, prefix);
+        prefix.pop_back();
+    });
+}
 
-// Inserir uma palavra na Trie
-void insert(TrieNode* root, const string& word) {
-    TrieNode* current = root;
-    for (char ch : word) {
-        if (current->children.find(ch) == current->children.end()) {
-            current->children[ch] = new TrieNode();
-        }
-        current = current->children[ch];
+void display(const LoudsTrie& trie, uint64_t node, string& prefix) {
+    if (isTerminal(trie, node)) {
+        cout << prefix << endl;
     }
-    current->isEndOfWord = true;
+
+    forEachChild(trie, node, [&](unsigned char ch, uint64_t child) {
+        prefix.push_back(ch);
+        display(trie, child, prefix);
+        prefix.pop_back();
+    });
 }
 
-// Buscar uma palavra na Trie
-bool search(TrieNode* root, const string& word) {
-    TrieNode* current = root;
-    for (char ch : word) {
-        if (current->children.find(ch) == current->children.end()) {
-            return false;
+// Arquivos Graphviz das Tries, gravados pelo exportador iterativo de
+// graphviz.h. Na Trie por caractere cada aresta é um caractere inteiro: os
+// nós intermediários de uma sequência UTF-8 não aparecem, para que os
+// rótulos sejam texto válido. Nos nós por byte (vetor duplo e LOUDS) o
+// rótulo é o byte da aresta.
+GraphvizResult saveGraph(TrieNode* root, const string& filename, GraphvizLimits limits = GraphvizLimits()) {
+    typedef pair<TrieNode*, string> Handle;  // nó e caractere da aresta que chega a ele
+    auto children = [](const Handle& h, auto visit) {
+        forEachCodepoint(h.first, [&](const string& character, TrieNode* child) { visit(Handle(child, character)); });
+    };
+    auto label = [](const Handle& h, DotWriter& out) {
+        out.writeEscaped(h.second.data(), h.second.size());
+        if (h.first->isEndOfWord) out << '*';
+    };
+    return saveGraphviz(filename, Handle(root, ""), children, label, limits);
+}
+
+GraphvizResult saveGraph(RadixNode* root, const string& filename, GraphvizLimits limits = GraphvizLimits()) {
+    auto children = [](RadixNode* node, auto visit) {
+        for (RadixNode* child : node->children) visit(child);
+    };
+    auto label = [](RadixNode* node, DotWriter& out) {
+        out.writeEscaped(node->label.data(), node->label.size());
+        if (node->isEndOfWord) out << '*';
+    };
+    return saveGraphviz(filename, root, children, label, limits);
+}
+
+GraphvizResult saveGraph(ArtTree* tree, const string& filename, GraphvizLimits limits = GraphvizLimits()) {
+    if (!tree->root) {
+        bool written = saveEmptyGraphviz(filename);
+        return {written, written, 0, 0, false};
+    }
+
+    typedef pair<ArtNode*, unsigned char> Handle;  // nó e byte da aresta que chega a ele
+    auto children = [](const Handle& h, auto visit) {
+        if (isLeaf(h.first)) return;
+        forEachChild(h.first, [&](unsigned char ch, ArtNode* child) { visit(Handle(child, ch)); });
+    };
+    auto label = [](const Handle& h, DotWriter& out) {
+        const char* names[] = {"N4", "N16", "N48", "N256"};
+        ArtNode* node = h.first;
+        if (isLeaf(node)) {
+            const ArtLeaf* leaf = asLeaf(node);
+            out.writeEscaped(leaf->key, leaf->length);
+            return;
+        }
+
+        out << names[node->type];
+        if (node->prefixLength) {
+            out << ' ';
+            out.writeEscaped((const char*)node->prefix, min<int>(node->prefixLength, ART_MAX_PREFIX));
+            if (node->prefixLength > ART_MAX_PREFIX) out << "...";
+        }
+    };
+    auto edgeAttributes = [](const Handle& h, DotWriter& out) {
+        out << " [label=\"";
+        if (h.second) out.writeEscaped((const char*)&h.second, 1);
+        out << "\"]";
+    };
+    return saveGraphviz(filename, Handle(tree->root, 0), children, label, edgeAttributes, limits);
+}
+
+GraphvizResult saveGraph(DoubleArrayTrie* trie, const string& filename, GraphvizLimits limits = GraphvizLimits()) {
+    typedef pair<int32_t, unsigned char> Handle;  // estado e byte da aresta que chega a ele
+    auto children = [trie](const Handle& h, auto visit) {
+        forEachChild(*trie, h.first, [&](unsigned char ch, int32_t child) { visit(Handle(child, ch)); });
+    };
+    auto label = [trie](const Handle& h, DotWriter& out) {
+        if (h.second) out.writeEscaped((const char*)&h.second, 1);
+        if (trie->terminal[h.first]) out << '*';
+    };
+    return saveGraphviz(filename, Handle(0, 0), children, label, limits);
+}
+
+GraphvizResult saveGraph(LoudsTrie* trie, const string& filename, GraphvizLimits limits = GraphvizLimits()) {
+    typedef pair<uint64_t, unsigned char> Handle;  // nó e byte da aresta que chega a ele
+    auto children = [trie](const Handle& h, auto visit) {
+        forEachChild(*trie, h.first, [&](unsigned char ch, uint64_t child) { visit(Handle(child, ch)); });
+    };
+    auto label = [trie](const Handle& h, DotWriter& out) {
+        if (h.second) out.writeEscaped((const char*)&h.second, 1);
+        if (isTerminal(*trie, h.first)) out << '*';
+    };
+    return saveGraphviz(filename, Handle(0, 0), children, label, limits);
+}
+
+// Implementações disponíveis da Trie, escolhidas no início do programa
+// (o snapshot LOUDS é somente leitura e vem de um arquivo)
+enum TrieKind { CHAR_TRIE = 1, RADIX_TRIE = 2, ART_TRIE = 3, LOUDS_TRIE = 4, DOUBLE_ARRAY_TRIE = 5, CONCURRENT_TRIE = 6 };
+
+struct Trie {
+    TrieKind kind;
+    TrieNode* root;
+    TrieArena* arena;
+    RadixNode* radixRoot;
+    ArtTree* art;
+    LoudsTrie* louds;
+    DoubleArrayTrie* doubleArray;
+    ConcurrentTrie* concurrent;
+
+    Trie(TrieKind k, const string& snapshot = "")
+        : kind(k), root(nullptr), arena(nullptr), radixRoot(nullptr), art(nullptr), louds(nullptr),
+          doubleArray(nullptr), concurrent(nullptr) {
+        if (kind == LOUDS_TRIE) {
+            louds = new LoudsTrie();
+            if (openLoudsSnapshot(snapshot, *louds)) return;
+
+            cerr << "Erro ao abrir o snapshot! Usando a Trie por caractere.\n";
+            delete louds;
+            louds = nullptr;
+            kind = CHAR_TRIE;
+        }
+
+        if (kind == RADIX_TRIE) {
+            radixRoot = new RadixNode();
+        } else if (kind == ART_TRIE) {
+            art = new ArtTree();
+        } else if (kind == DOUBLE_ARRAY_TRIE) {
+            doubleArray = new DoubleArrayTrie();
+        } else if (kind == CONCURRENT_TRIE) {
+            concurrent = new ConcurrentTrie();
+        } else {
+            arena = new TrieArena();
+            root = createNode(arena);
         }
-        current = current->children[ch];
     }
-    return current->isEndOfWord;
+};
+
+// Versões que despacham para a implementação escolhida
+void insert(Trie& trie, const string& word) {
+    switch (trie.kind) {
+        case RADIX_TRIE: insert(trie.radixRoot, word); break;
+        case ART_TRIE: insert(trie.art, word); break;
+        case LOUDS_TRIE: cout << "Snapshot somente leitura.\n"; break;
+        case DOUBLE_ARRAY_TRIE: insert(trie.doubleArray, word); break;
+        case CONCURRENT_TRIE: insert(*trie.concurrent, word); break;
+        default: insert(trie.root, word, trie.arena);
+    }
 }
 
-// Remover uma palavra da Trie
-bool remove(TrieNode* current, const string& word, int depth = 0) {
-    if (!current) return false;
+bool search(Trie& trie, const string& word) {
+    switch (trie.kind) {
+        case RADIX_TRIE: return search(trie.radixRoot, word);
+        case ART_TRIE: return search(trie.art, word);
+        case LOUDS_TRIE: return search(*trie.louds, word);
+        case DOUBLE_ARRAY_TRIE: return search(trie.doubleArray, word);
+        case CONCURRENT_TRIE: return search(*trie.concurrent, word);
+        default: return search(trie.root, word);
+    }
+}
 
-    if (depth == word.size()) {
-        if (!current->isEndOfWord) return false;
-        current->isEndOfWord = false;
-        return current->children.empty();
+bool remove(Trie& trie, const string& word) {
+    switch (trie.kind) {
+        case RADIX_TRIE: return remove(trie.radixRoot, word);
+        case ART_TRIE: return remove(trie.art, word);
+        case LOUDS_TRIE: cout << "Snapshot somente leitura.\n"; return false;
+        case DOUBLE_ARRAY_TRIE: return remove(trie.doubleArray, word);
+        case CONCURRENT_TRIE: return remove(*trie.concurrent, word);
+        default: return remove(trie.root, word, 0, trie.arena);
+    }
+}
+
+void display(Trie& trie) {
+    string prefix;
+    switch (trie.kind) {
+        case RADIX_TRIE: display(trie.radixRoot, prefix); break;
+        case ART_TRIE: if (trie.art->root) display(trie.art->root); break;
+        case LOUDS_TRIE: display(*trie.louds, 0, prefix); break;
+        case DOUBLE_ARRAY_TRIE: display(*trie.doubleArray, 0, prefix); break;
+        case CONCURRENT_TRIE: display(trie.concurrent->root.load(), prefix); break;
+        default: display(trie.root, prefix);
     }
+}
 
-    char ch = word[depth];
-    if (current->children.find(ch) != current->children.end() && 
-        remove(current->children[ch], word, depth + 1)) {
-        delete current->children[ch];
-        current->children.erase(ch);
-        return !current->isEndOfWord && current->children.empty();
+void saveGraphToFile(Trie& trie, const string& filename) {
+    GraphvizResult result;
+    switch (trie.kind) {
+        case RADIX_TRIE: result = saveGraph(trie.radixRoot, filename); break;
+        case ART_TRIE: result = saveGraph(trie.art, filename); break;
+        case LOUDS_TRIE: result = saveGraph(trie.louds, filename); break;
+        case DOUBLE_ARRAY_TRIE: result = saveGraph(trie.doubleArray, filename); break;
+        case CONCURRENT_TRIE: result = saveGraph(trie.concurrent->root.load(), filename); break;
+        default: result = saveGraph(trie.root, filename);
     }
 
-    return false;
+    if (!result.written) {
+        cerr << "Erro ao abrir o arquivo!\n";
+        return;
+    }
+    cout << "Arquivo DOT gerado: " << filename << endl;
 }
 
-// Exibir palavras armazenadas na Trie
-void display(TrieNode* root, string& prefix) {
-    if (root->isEndOfWord) {
-        cout << prefix << endl;
+// Raiz dos nós por caractere: a da Trie por caractere ou a versão atual da
+// concorrente (nullptr nas outras implementações)
+TrieNode* charRoot(Trie& trie) {
+    if (trie.kind == CONCURRENT_TRIE) return trie.concurrent->root.load();
+    return trie.kind == CHAR_TRIE ? trie.root : nullptr;
+}
+
+// Palavras com o prefixo e autocompletar (só os nós por caractere guardam pesos)
+void displayPrefix(Trie& trie, const string& prefix) {
+    if (trie.kind == LOUDS_TRIE) {
+        int64_t node = findPrefix(*trie.louds, prefix);
+        string word = prefix;
+        if (node >= 0) display(*trie.louds, node, word);
+        return;
+    }
+    if (trie.kind == DOUBLE_ARRAY_TRIE) {
+        int32_t state = findPrefix(*trie.doubleArray, prefix);
+        string word = prefix;
+        if (state >= 0) display(*trie.doubleArray, state, word);
+        return;
+    }
+    if (!charRoot(trie)) {
+        cout << "Disponível apenas na Trie por caractere.\n";
+        return;
     }
 
-    for (auto& pair : root->children) {
-        prefix.push_back(pair.first);
-        display(pair.second, prefix);
-        prefix.pop_back();
+    CompletionIterator it = completions(charRoot(trie), prefix);
+    string word;
+    while (nextCompletion(it, word)) {
+        cout << word << endl;
+    }
+}
+
+// Congelar a Trie por caractere num snapshot LOUDS
+void saveSnapshot(Trie& trie, const string& filename) {
+    if (!charRoot(trie)) {
+        cout << "Disponível apenas na Trie por caractere.\n";
+        return;
+    }
+
+    if (saveLoudsSnapshot(charRoot(trie), filename)) {
+        cout << "Snapshot gravado: " << filename << endl;
+    }
+}
+
+// Caracteres (pontos de código) que podem seguir o prefixo, com o maior
+// peso de palavra alcançável por cada um
+void displayNextCharacters(Trie& trie, const string& prefix) {
+    if (!charRoot(trie)) {
+        cout << "Disponível apenas na Trie por caractere.\n";
+        return;
+    }
+
+    TrieNode* node = findPrefix(charRoot(trie), prefix);
+    if (!node) return;
+    forEachCodepoint(node, [](const string& character, TrieNode* child) {
+        cout << character << " (" << child->maxWeight << ")" << endl;
+    });
+}
+
+void displayTopCompletions(Trie& trie, const string& prefix, int k) {
+    if (!charRoot(trie)) {
+        cout << "Disponível apenas na Trie por caractere.\n";
+        return;
+    }
+
+    for (const auto& completion : topCompletions(charRoot(trie), prefix, k)) {
+        cout << completion.first << " (" << completion.second << ")" << endl;
+    }
+}
+
+// Função auxiliar para medir o tempo decorrido em segundos
+double elapsedSeconds(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Bytes alocados pelo malloc no momento (glibc)
+size_t allocatedBytes() {
+    return mallinfo2().uordblks + mallinfo2().hblkhd;
+}
+
+// Memória residente do processo em KB (Linux)
+long residentKilobytes() {
+    ifstream statm("/proc/self/statm");
+    long size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Pico de memória residente em KB desde o último resetPeakResident (Linux)
+long peakResidentKilobytes() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return stol(line.substr(6));
     }
+    return 0;
+}
+
+void resetPeakResident() {
+    ofstream("/proc/self/clear_refs") << "5";
 }
 
-// Gerar representação Graphviz para a Trie
-void generateGraphviz(TrieNode* node, ofstream& file, int& nodeId, int parentId = -1, char edgeLabel = '\0') {
-    int currentNodeId = nodeId++;
-    file << "  node" << currentNodeId << " [label=\"";
-    if (edgeLabel != '\0') file << edgeLabel;
-    if (node->isEndOfWord) file << "*";
-    file << "\"]\n";
+// Gera palavras sintéticas a partir de sílabas, para que compartilhem
+// prefixos como num dicionário real
+vector<string> generateWords(int count) {
+    const char* consonants = "bcdfghjklmnprstvz";
+    const char* vowels = "aeiou";
+    mt19937 rng(42);
 
-    if (parentId != -1) {
-        file << "  node" << parentId << " -> node" << currentNodeId << "\n";
+    vector<string> words;
+    words.reserve(count);
+    for (int i = 0; i < count; i++) {
+        string word;
+        int syllables = 2 + rng() % 4;
+        for (int s = 0; s < syllables; s++) {
+            word.push_back(consonants[rng() % 17]);
+            word.push_back(vowels[rng() % 5]);
+            if (rng() % 4 == 0) word.push_back(consonants[rng() % 17]);
+        }
+        words.push_back(word);
     }
+    return words;
+}
 
-    for (auto& pair : node->children) {
-        generateGraphviz(pair.second, file, nodeId, currentNodeId, pair.first);
+// Palavras sintéticas com 2 a 4 ideogramas CJK (3 bytes cada em UTF-8). Os
+// ideogramas saem de um conjunto de 3000, com os primeiros bem mais
+// frequentes, para que as palavras compartilhem prefixos.
+vector<string> generateCjkWords(int count) {
+    mt19937 rng(42);
+
+    vector<string> words;
+    words.reserve(count);
+    for (int i = 0; i < count; i++) {
+        string word;
+        int characters = 2 + rng() % 3;
+        for (int c = 0; c < characters; c++) {
+            uint32_t rank = rng() % 3000;
+            appendUtf8(word, 0x4E00 + rank * (rng() % 3000) / 3000);
+        }
+        words.push_back(word);
     }
+    return words;
 }
 
-void saveGraphToFile(TrieNode* root, const string& filename) {
-    ofstream file(filename);
+// Lê as palavras de um arquivo (uma por linha)
+vector<string> readWords(const string& filename) {
+    vector<string> words;
+    ifstream file(filename);
     if (!file.is_open()) {
         cerr << "Erro ao abrir o arquivo!\n";
+        return words;
+    }
+
+    string word;
+    while (getline(file, word)) {
+        if (!word.empty()) words.push_back(word);
+    }
+    return words;
+}
+
+// Lê as palavras de um arquivo ou gera count palavras se o nome for "-"
+vector<string> loadWords() {
+    string filename;
+    cout << "Arquivo de palavras (ou - para gerar): ";
+    cin >> filename;
+
+    if (filename == "-") {
+        int count;
+        cout << "Quantidade de palavras: ";
+        cin >> count;
+        return generateWords(count);
+    }
+
+    return readWords(filename);
+}
+
+// Inserir todas as palavras de um arquivo; a Trie por caractere usa a
+// inserção em lote com uma thread por núcleo
+void loadFile(Trie& trie, const string& filename) {
+    vector<string> words = readWords(filename);
+
+    // Linhas que não são UTF-8 válido ficam de fora
+    size_t valid = 0;
+    for (const string& w : words) {
+        if (isValidUtf8(w)) words[valid++] = w;
+    }
+    if (valid < words.size()) cout << words.size() - valid << " linhas com UTF-8 inválido ignoradas.\n";
+    words.resize(valid);
+
+    // A ART não aceita o byte 0 (U+0000 é UTF-8 válido)
+    if (trie.kind == ART_TRIE) {
+        valid = 0;
+        for (const string& w : words) {
+            if (!hasNulByte(w)) words[valid++] = w;
+        }
+        if (valid < words.size()) cout << words.size() - valid << " linhas com o byte 0 ignoradas.\n";
+        words.resize(valid);
+    }
+
+    if (trie.kind == CHAR_TRIE) {
+        bulkInsert(trie.root, words, trie.arena, max(1u, thread::hardware_concurrency()));
+    } else {
+        for (const string& w : words) insert(trie, w);
+    }
+    cout << words.size() << " palavras carregadas.\n";
+}
+
+// Constrói a Trie com as palavras e mede tempo, memória e buscas por segundo
+template <typename Node>
+void measureTrie(const char* name, vector<string> words, Node* root) {
+    size_t before = allocatedBytes();
+    auto start = chrono::steady_clock::now();
+
+    for (const string& w : words) {
+        insert(root, w);
+    }
+
+    double buildTime = elapsedSeconds(start);
+    size_t after = allocatedBytes();
+
+    shuffle(words.begin(), words.end(), mt19937(1));
+    start = chrono::steady_clock::now();
+    long found = 0;
+    for (const string& w : words) {
+        found += search(root, w);
+    }
+    double lookupTime = elapsedSeconds(start);
+
+    cout << name << ": " << words.size() << " palavras"
+         << " | construção: " << buildTime << " s"
+         << " | memória: " << (double)(after - before) / words.size() << " bytes/palavra"
+         << " | buscas: " << words.size() / lookupTime / 1e6 << " M/s"
+         << (found == (long)words.size() ? "" : " | ERRO: palavra não encontrada") << endl;
+
+    destroy(root);
+}
+
+// Memória por palavra e buscas por segundo
+void benchmarkLookup() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    measureTrie("Trie", words, new TrieNode());
+}
+
+// Trie por caractere x Trie compactada (use uma lista de caminhos de arquivo)
+void benchmarkRadix() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    measureTrie("Radix", words, new RadixNode());
+    measureTrie("Trie", words, new TrieNode());
+}
+
+// Chaves inteiras de 8 bytes em big-endian, para que a ordem dos bytes
+// siga a ordem numérica
+string integerKey(uint64_t value) {
+    string key(8, '\0');
+    for (int i = 7; i >= 0; i--) {
+        key[i] = value & 0xff;
+        value >>= 8;
+    }
+    return key;
+}
+
+// ART x Trie compactada x Trie por caractere com chaves densas (inteiros
+// consecutivos), esparsas (inteiros aleatórios de 64 bits) e palavras
+void benchmarkArt() {
+    int count;
+    cout << "Quantidade de chaves: ";
+    cin >> count;
+
+    vector<string> dense, sparse;
+    mt19937_64 rng(42);
+    for (int i = 0; i < count; i++) {
+        dense.push_back(integerKey(i));
+        sparse.push_back(integerKey(rng()));
+    }
+
+    const vector<string>* sets[] = {&dense, &sparse};
+    const char* names[] = {"densas", "esparsas", "palavras"};
+    for (int s = 0; s < 3; s++) {
+        vector<string> words = s < 2 ? *sets[s] : generateWords(count);
+
+        cout << "Chaves " << names[s] << ":\n";
+        measureTrie("  ART", words, new ArtTree());
+        measureTrie("  Radix", words, new RadixNode());
+        measureTrie("  Trie", words, new TrieNode());
+    }
+}
+
+// Construção e descarte da Trie com new/delete e com a arena
+void benchmarkArena() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    for (int useArena = 0; useArena < 2; useArena++) {
+        long rssBefore = residentKilobytes();
+        auto start = chrono::steady_clock::now();
+
+        TrieArena* arena = useArena ? new TrieArena() : nullptr;
+        TrieNode* root = createNode(arena);
+        for (const string& w : words) {
+            insert(root, w, arena);
+        }
+
+        double buildTime = elapsedSeconds(start);
+        long rssBuilt = residentKilobytes();
+
+        start = chrono::steady_clock::now();
+        if (arena) delete arena;
+        else destroy(root);
+        double teardownTime = elapsedSeconds(start);
+        long rssAfter = residentKilobytes();
+
+        cout << (useArena ? "arena" : "new/delete") << ": " << words.size() << " palavras"
+             << " | construção: " << buildTime << " s"
+             << " | descarte: " << teardownTime * 1e3 << " ms"
+             << " | RSS: +" << (rssBuilt - rssBefore) / 1024 << " MB, após descarte +"
+             << (rssAfter - rssBefore) / 1024 << " MB" << endl;
+    }
+}
+
+// Percentil p (entre 0 e 1) de uma amostra de tempos
+double percentile(vector<double> samples, double p) {
+    sort(samples.begin(), samples.end());
+    return samples[(size_t)(p * (samples.size() - 1))];
+}
+
+// Latência do autocompletar (top-10) com prefixos de 1 a 3 caracteres:
+// busca guiada pelo maior peso da subárvore x percorrer todas as palavras
+// do prefixo e escolher as 10 mais pesadas. Os pesos seguem Zipf pela
+// posição na lista (listas de frequência costumam vir ordenadas).
+void benchmarkCompletion() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    const int k = 10;
+    const int queries = 500;
+
+    TrieArena arena;
+    TrieNode* root = createNode(&arena);
+    for (size_t i = 0; i < words.size(); i++) {
+        insert(root, words[i], &arena, 100000000 / (i + 1) + 1);
+    }
+
+    mt19937 rng(7);
+    for (size_t length = 1; length <= 3; length++) {
+        vector<double> guided, exhaustive;
+        long mismatches = 0;
+
+        for (int q = 0; q < queries; q++) {
+            string prefix = words[rng() % words.size()].substr(0, length);
+
+            auto start = chrono::steady_clock::now();
+            vector<pair<string, uint32_t>> top = topCompletions(root, prefix, k);
+            guided.push_back(elapsedSeconds(start));
+
+            start = chrono::steady_clock::now();
+            vector<uint32_t> weights;
+            CompletionIterator it = completions(root, prefix);
+            string word;
+            uint32_t weight;
+            while (nextCompletion(it, word, &weight)) weights.push_back(weight);
+            size_t count = min((size_t)k, weights.size());
+            partial_sort(weights.begin(), weights.begin() + count, weights.end(), greater<uint32_t>());
+            exhaustive.push_back(elapsedSeconds(start));
+
+            for (size_t i = 0; i < count; i++) {
+                if (i >= top.size() || top[i].second != weights[i]) {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+
+        cout << "Prefixo de " << length << " caractere(s): top-" << k
+             << " p50 " << percentile(guided, 0.5) * 1e6 << " us, p99 " << percentile(guided, 0.99) * 1e6 << " us"
+             << " | percurso completo p50 " << percentile(exhaustive, 0.5) * 1e6 << " us, p99 "
+             << percentile(exhaustive, 0.99) * 1e6 << " us"
+             << (mismatches ? " | ERRO: resultados diferentes" : "") << endl;
+    }
+}
+
+// Partida com snapshot LOUDS x reconstruir a Trie inserindo palavra por
+// palavra. O snapshot é retirado do cache de páginas antes de ser mapeado,
+// então a partida e as primeiras buscas incluem a leitura do disco.
+void benchmarkSnapshot() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    const string filename = "trie.louds";
+    vector<string> queries = words;
+    shuffle(queries.begin(), queries.end(), mt19937(1));
+    queries.resize(min<size_t>(queries.size(), 1000));
+
+    size_t before = allocatedBytes();
+    auto start = chrono::steady_clock::now();
+    TrieArena* arena = new TrieArena();
+    TrieNode* root = createNode(arena);
+    for (const string& w : words) {
+        insert(root, w, arena);
+    }
+    double buildTime = elapsedSeconds(start);
+    size_t trieBytes = allocatedBytes() - before;
+
+    start = chrono::steady_clock::now();
+    long found = 0;
+    for (const string& w : queries) found += search(root, w);
+    double trieQueries = elapsedSeconds(start);
+
+    start = chrono::steady_clock::now();
+    if (!saveLoudsSnapshot(root, filename)) {
+        delete arena;
+        return;
+    }
+    double saveTime = elapsedSeconds(start);
+    delete arena;
+
+    // Descartar as páginas do arquivo do cache para medir a partida a frio
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+
+    LoudsTrie louds;
+    start = chrono::steady_clock::now();
+    if (!openLoudsSnapshot(filename, louds)) {
+        cerr << "Erro ao abrir o snapshot!\n";
         return;
     }
+    double openTime = elapsedSeconds(start);
 
-    file << "digraph G {\nnode [shape=circle];\n";
+    start = chrono::steady_clock::now();
+    for (const string& w : queries) found += search(louds, w);
+    double snapshotQueries = elapsedSeconds(start);
 
-    int nodeId = 0;
-    generateGraphviz(root, file, nodeId);
+    start = chrono::steady_clock::now();
+    for (const string& w : words) found += search(louds, w);
+    double lookupTime = elapsedSeconds(start);
 
-    file << "}\n";
-    file.close();
+    cout << "Reconstrução: " << words.size() << " palavras"
+         << " | partida: " << buildTime << " s"
+         << " | memória: " << (double)trieBytes / words.size() << " bytes/palavra"
+         << " | " << queries.size() << " buscas: " << trieQueries * 1e3 << " ms" << endl;
+    cout << "Snapshot LOUDS: gravação " << saveTime << " s"
+         << " | partida (mmap): " << openTime * 1e3 << " ms"
+         << " | arquivo: " << (double)louds.mappingSize / words.size() << " bytes/palavra"
+         << " | " << queries.size() << " primeiras buscas (a frio): " << snapshotQueries * 1e3 << " ms"
+         << " | buscas: " << words.size() / lookupTime / 1e6 << " M/s"
+         << (found == (long)(2 * queries.size() + words.size()) ? "" : " | ERRO: palavra não encontrada") << endl;
 
-    cout << "Arquivo DOT gerado: " << filename << endl;
+    closeLoudsSnapshot(louds);
+}
+
+// Transições por segundo: Trie por caractere (filhos no nó ou tabela) x
+// vetor duplo construído por inserção incremental e pela construção
+// estática a partir das palavras ordenadas
+void benchmarkDoubleArray() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    vector<string> sorted = words;
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+
+    vector<string> queries = words;
+    shuffle(queries.begin(), queries.end(), mt19937(1));
+    long transitions = 0;
+    for (const string& w : queries) transitions += w.size();
+
+    for (int variant = 0; variant < 3; variant++) {
+        const char* names[] = {"Trie", "Vetor duplo (incremental)", "Vetor duplo (estático)"};
+        TrieArena arena;
+        TrieNode* root = nullptr;
+        DoubleArrayTrie doubleArray;
+
+        size_t before = allocatedBytes();
+        auto start = chrono::steady_clock::now();
+        if (variant == 0) {
+            root = createNode(&arena);
+            for (const string& w : words) insert(root, w, &arena);
+        } else if (variant == 1) {
+            for (const string& w : words) insert(&doubleArray, w);
+        } else {
+            buildDoubleArray(doubleArray, sorted);
+        }
+        double buildTime = elapsedSeconds(start);
+        size_t bytes = allocatedBytes() - before;
+
+        start = chrono::steady_clock::now();
+        long found = 0;
+        for (const string& w : queries) {
+            found += variant == 0 ? search(root, w) : search(&doubleArray, w);
+        }
+        double lookupTime = elapsedSeconds(start);
+
+        cout << names[variant] << ": " << words.size() << " palavras"
+             << " | construção: " << buildTime << " s"
+             << " | memória: " << (double)bytes / words.size() << " bytes/palavra"
+             << " | transições: " << transitions / lookupTime / 1e6 << " M/s"
+             << (found == (long)queries.size() ? "" : " | ERRO: palavra não encontrada") << endl;
+    }
+}
+
+// Compara duas Tries por caractere nó a nó (filhos, palavras e pesos)
+bool sameTrie(TrieNode* a, TrieNode* b) {
+    if (a->childCount != b->childCount || a->isEndOfWord != b->isEndOfWord ||
+        a->weight != b->weight || a->maxWeight != b->maxWeight) {
+        return false;
+    }
+
+    bool same = true;
+    forEachChild(a, [&](unsigned char ch, TrieNode* child) {
+        TrieNode* other = findChild(b, ch);
+        same = same && other && sameTrie(child, other);
+    });
+    return same;
+}
+
+// Construção serial x inserção em lote com 1, 2, 4... threads; cada Trie em
+// lote é comparada com a serial
+void benchmarkBulkInsert() {
+    vector<string> words = loadWords();
+    if (words.empty()) return;
+
+    auto start = chrono::steady_clock::now();
+    TrieArena serialArena;
+    TrieNode* serial = createNode(&serialArena);
+    for (const string& w : words) insert(serial, w, &serialArena);
+    double serialTime = elapsedSeconds(start);
+    cout << "Serial: " << words.size() << " palavras | construção: " << serialTime << " s" << endl;
+
+    int maxThreads = max(2u, thread::hardware_concurrency());
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        start = chrono::steady_clock::now();
+        TrieArena arena;
+        TrieNode* root = createNode(&arena);
+        bulkInsert(root, words, &arena, threads);
+        double buildTime = elapsedSeconds(start);
+
+        cout << "Em lote, " << threads << " thread(s): construção: " << buildTime << " s"
+             << " | aceleração: " << serialTime / buildTime << "x"
+             << (sameTrie(serial, root) ? "" : " | ERRO: Trie diferente da serial") << endl;
+    }
+}
+
+// Leitores sem trava x um escritor que insere e remove palavras a taxas
+// crescentes (0 = sem escritor, -1 = sem pausa). As palavras buscadas nunca
+// são removidas, então toda busca deve encontrá-las.
+void benchmarkConcurrent() {
+    vector<string> words = loadWords();
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    shuffle(words.begin(), words.end(), mt19937(1));
+    if (words.size() < 2) return;
+
+    int readers = min(CONCURRENT_MAX_READERS, max(1, (int)thread::hardware_concurrency() - 1));
+    const double seconds = 1.0;
+
+    // Metade das palavras fica fixa (inserida antes de haver leitores); a
+    // outra metade é inserida e removida pelo escritor
+    ConcurrentTrie* trie = new ConcurrentTrie();
+    size_t half = words.size() / 2;
+    for (size_t i = 0; i < half; i++) insert(trie->root.load(), words[i]);
+
+    const int rates[] = {0, 100, 1000, 10000, 100000, -1};
+    for (int rate : rates) {
+        atomic<bool> running{true};
+        atomic<long> searches{0}, misses{0};
+        long writes = 0;
+
+        vector<thread> workers;
+        for (int r = 0; r < readers; r++) {
+            workers.emplace_back([&, r]() {
+                mt19937 rng(r);
+                long count = 0, missing = 0;
+                while (running.load(memory_order_relaxed)) {
+                    for (int i = 0; i < 256; i++) {
+                        missing += !search(*trie, words[rng() % half], r);
+                    }
+                    count += 256;
+                }
+                searches += count;
+                misses += missing;
+            });
+        }
+
+        auto start = chrono::steady_clock::now();
+        while (elapsedSeconds(start) < seconds) {
+            if (rate == 0) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+                continue;
+            }
+
+            const string& w = words[half + (writes / 2) % (words.size() - half)];
+            if (writes % 2 == 0) insert(*trie, w);
+            else remove(*trie, w);
+            writes++;
+
+            if (rate > 0) this_thread::sleep_until(start + chrono::duration<double>((double)writes / rate));
+        }
+        running = false;
+        for (thread& w : workers) w.join();
+        double elapsed = elapsedSeconds(start);
+
+        cout << "Escritor: " << (rate < 0 ? "sem pausa" : to_string(rate) + "/s")
+             << " (real " << (long)(writes / elapsed) << "/s)"
+             << " | " << readers << " leitor(es): " << searches / elapsed / 1e6 << " M buscas/s"
+             << (misses ? " | ERRO: palavra fixa não encontrada" : "") << endl;
+    }
+
+    destroy(trie);
+}
+
+// Trie por caractere com palavras ASCII e com palavras CJK: construção,
+// memória, buscas (palavras e bytes por segundo), validação UTF-8 e
+// listagem por ponto de código
+void benchmarkUtf8() {
+    int count;
+    cout << "Quantidade de palavras: ";
+    cin >> count;
+
+    const char* names[] = {"ASCII", "CJK"};
+    for (int corpus = 0; corpus < 2; corpus++) {
+        vector<string> words = corpus == 0 ? generateWords(count) : generateCjkWords(count);
+        size_t bytes = 0;
+        for (const string& w : words) bytes += w.size();
+
+        auto start = chrono::steady_clock::now();
+        long valid = 0;
+        for (const string& w : words) valid += isValidUtf8(w);
+        double validateTime = elapsedSeconds(start);
+
+        TrieArena arena;
+        size_t before = allocatedBytes();
+        start = chrono::steady_clock::now();
+        TrieNode* root = createNode(&arena);
+        for (const string& w : words) insert(root, w, &arena);
+        double buildTime = elapsedSeconds(start);
+        size_t memory = allocatedBytes() - before;
+
+        vector<string> queries = words;
+        shuffle(queries.begin(), queries.end(), mt19937(1));
+        start = chrono::steady_clock::now();
+        long found = 0;
+        for (const string& w : queries) found += search(root, w);
+        double lookupTime = elapsedSeconds(start);
+
+        // Conta os caracteres de todas as arestas percorrendo por ponto de código
+        start = chrono::steady_clock::now();
+        long characters = 0;
+        vector<TrieNode*> pending(1, root);
+        while (!pending.empty()) {
+            TrieNode* node = pending.back();
+            pending.pop_back();
+            forEachCodepoint(node, [&](const string&, TrieNode* child) {
+                characters++;
+                pending.push_back(child);
+            });
+        }
+        double iterateTime = elapsedSeconds(start);
+
+        cout << names[corpus] << ": " << words.size() << " palavras, " << (double)bytes / words.size() << " bytes/palavra"
+             << " | construção: " << buildTime << " s"
+             << " | memória: " << (double)memory / words.size() << " bytes/palavra"
+             << " | buscas: " << words.size() / lookupTime / 1e6 << " M/s, " << bytes / lookupTime / 1e6 << " MB/s"
+             << " | validação UTF-8: " << bytes / validateTime / 1e6 << " MB/s"
+             << " | listagem: " << characters / iterateTime / 1e6 << " M caracteres/s"
+             << (found == (long)words.size() && valid == (long)words.size() ? "" : " | ERRO") << endl;
+    }
+}
+
+// Exportação Graphviz de uma cadeia de n nós (uma única palavra de n
+// caracteres, que estouraria a pilha num percurso recursivo) e da Trie de
+// n/3 palavras geradas (perto de n nós), com e sem limite de profundidade. O pico de memória
+// é medido só durante a exportação.
+void benchmarkGraphviz() {
+    int count;
+    cout << "Quantidade de nós: ";
+    cin >> count;
+
+    const string filename = "benchmark.dot";
+    for (int shape = 0; shape < 3; shape++) {
+        const char* names[] = {"Cadeia", "Palavras", "Palavras, profundidade <= 4"};
+        TrieArena arena;
+        TrieNode* root = createNode(&arena);
+        if (shape == 0) {
+            insert(root, string(count, 'a'), &arena);
+        } else {
+            for (const string& w : generateWords(count / 3)) insert(root, w, &arena);
+        }
+
+        remove(filename.c_str());
+        long residentBefore = residentKilobytes();
+        resetPeakResident();
+        auto start = chrono::steady_clock::now();
+        GraphvizResult result = saveGraph(root, filename, GraphvizLimits(shape == 2 ? 4 : -1));
+        double exportTime = elapsedSeconds(start);
+        long peak = peakResidentKilobytes();
+
+        if (!result.written) {
+            cerr << "Erro ao abrir o arquivo!\n";
+            return;
+        }
+
+        ifstream file(filename, ios::binary | ios::ate);
+        double megabytes = file.tellg() / 1e6;
+        cout << names[shape] << ": " << result.nodes << " nós | exportação: " << exportTime << " s"
+             << " (" << megabytes / exportTime << " MB/s)"
+             << " | pilha explícita: " << result.maxPending << " nós"
+             << " | pico de memória: +" << max(0L, peak - residentBefore) / 1024 << " MB"
+             << (result.truncated ? " | cortada pelo limite" : "") << endl;
+    }
+    remove(filename.c_str());
+}
+
+// Submenu com os benchmarks da Trie
+void runBenchmarks() {
+    int choice;
+    cout << "\n1. Memória e buscas\n2. Trie por caractere x compactada\n3. ART: chaves densas, esparsas e palavras\n4. Arena x new/delete\n5. Autocompletar por prefixo\n6. Snapshot LOUDS x reconstrução\n7. Vetor duplo x Trie por caractere\n8. Construção em paralelo\n9. Leituras concorrentes x taxa de escrita\n10. UTF-8: ASCII x CJK\n11. Exportação Graphviz\nEscolha um benchmark: ";
+    cin >> choice;
+
+    switch (choice) {
+        case 1:
+            benchmarkLookup();
+            break;
+        case 2:
+            benchmarkRadix();
+            break;
+        case 3:
+            benchmarkArt();
+            break;
+        case 4:
+            benchmarkArena();
+            break;
+        case 5:
+            benchmarkCompletion();
+            break;
+        case 6:
+            benchmarkSnapshot();
+            break;
+        case 7:
+            benchmarkDoubleArray();
+            break;
+        case 8:
+            benchmarkBulkInsert();
+            break;
+        case 9:
+            benchmarkConcurrent();
+            break;
+        case 10:
+            benchmarkUtf8();
+            break;
+        case 11:
+            benchmarkGraphviz();
+            break;
+        default:
+            cout << "Opção inválida.\n";
+    }
 }
 
 int main() {
-    TrieNode* root = new TrieNode();
     int choice;
     string word;
 
+    cout << "Escolha o tipo de Trie: (1 para Trie por caractere, 2 para Trie compactada, 3 para ART, 4 para snapshot LOUDS, 5 para vetor duplo, 6 para concorrente): ";
+    cin >> choice;
+    if (choice == LOUDS_TRIE) {
+        cout << "Arquivo do snapshot: ";
+        cin >> word;
+    }
+    Trie trie(choice >= RADIX_TRIE && choice <= CONCURRENT_TRIE ? (TrieKind)choice : CHAR_TRIE, word);
+
     while (true) {
-        cout << "\n1. Inserir Palavra\n2. Buscar Palavra\n3. Remover Palavra\n4. Exibir Palavras\n5. Gerar Grafo\n6. Sair\nEscolha uma opção: ";
+        cout << "\n1. Inserir Palavra\n2. Buscar Palavra\n3. Remover Palavra\n4. Exibir Palavras\n5. Gerar Grafo\n6. Listar por Prefixo\n7. Autocompletar\n8. Próximos Caracteres\n9. Salvar Snapshot\n10. Carregar Arquivo\n11. Benchmarks\n12. Sair\nEscolha uma opção: ";
         cin >> choice;
 
         switch (choice) {
             case 1:
                 cout << "Digite a palavra para inserir: ";
                 cin >> word;
-                insert(root, word);
+                if (isValidUtf8(word)) {
+                    insert(trie, word);
+                } else {
+                    cout << "Palavra com UTF-8 inválido.\n";
+                }
                 break;
             case 2:
                 cout << "Digite a palavra para buscar: ";
                 cin >> word;
-                if (search(root, word)) {
+                if (search(trie, word)) {
                     cout << "Palavra encontrada!\n";
                 } else {
                     cout << "Palavra não encontrada.\n";
@@ -132,23 +2929,50 @@ int main() {
             case 3:
                 cout << "Digite a palavra para remover: ";
                 cin >> word;
-                if (remove(root, word)) {
+                if (remove(trie, word)) {
                     cout << "Palavra removida com sucesso!\n";
                 } else {
                     cout << "Palavra não encontrada ou não pôde ser removida.\n";
                 }
                 break;
             case 4:
-                {
-                    string prefix;
-                    cout << "Palavras armazenadas na Trie:\n";
-                    display(root, prefix);
-                }
+                cout << "Palavras armazenadas na Trie:\n";
+                display(trie);
                 break;
             case 5:
-                saveGraphToFile(root, "trie.dot");
+                saveGraphToFile(trie, "trie.dot");
                 break;
             case 6:
+                cout << "Digite o prefixo: ";
+                cin >> word;
+                displayPrefix(trie, word);
+                break;
+            case 7: {
+                int k;
+                cout << "Digite o prefixo: ";
+                cin >> word;
+                cout << "Quantidade de sugestões: ";
+                cin >> k;
+                displayTopCompletions(trie, word, k);
+                break;
+            }
+            case 8:
+                cout << "Digite o prefixo: ";
+                cin >> word;
+                displayNextCharacters(trie, word);
+                break;
+            case 9:
+                saveSnapshot(trie, "trie.louds");
+                break;
+            case 10:
+                cout << "Arquivo de palavras: ";
+                cin >> word;
+                loadFile(trie, word);
+                break;
+            case 11:
+                runBenchmarks();
+                break;
+            case 12:
                 cout << "Saindo...\n";
                 return 0;
             default: